@@ -0,0 +1,160 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks that the scan path of the driver does no heap allocation once it is warmed up:
+// reading the serial port, framing, decoding, publishing the LaserScan and the PointCloud2
+// and updating the diagnostics, i.e. every call of SickS300::receiveScan.
+//
+// The telegrams are written one by one to a pseudo-terminal opened by the driver. The
+// first ones are not checked, as they size the buffers and the messages. Exits with a
+// failure if any allocation is made afterwards.
+//
+// Usage: allocation_check [--capture FILE] [--protocol 0102|0301|0301-fields] [--scans N]
+
+// C
+#include <pty.h>
+#include <unistd.h>
+
+// C++
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// ROS
+#include "lifecycle_msgs/msg/state.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "benchmark_utils.hpp"
+#include "sicks300_ros2/sicks300.hpp"
+
+namespace
+{
+
+// Telegrams received before the allocations are counted
+const size_t c_iWarmUpTelegrams = 100;
+
+// Longest wait for a telegram written to the pseudo-terminal
+const double c_dReadTimeout = 1.0;
+
+// Exposes the steps of the driver that are not reachable from outside
+class CheckedSickS300 : public sicks300_ros2::SickS300
+{
+public:
+  explicit CheckedSickS300(const rclcpp::NodeOptions & options)
+  : SickS300(options)
+  {
+  }
+
+  // Receives until the scanner has framed the given number of telegrams
+  bool receive(unsigned int telegrams)
+  {
+    while (scanner_.getReceivedTelegrams() < telegrams) {
+      if (!scanner_.waitForData(c_dReadTimeout)) {return false;}
+      receiveScan();
+    }
+    return true;
+  }
+
+  unsigned int getReceivedTelegrams() const {return scanner_.getReceivedTelegrams();}
+};
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  benchmark::Settings settings;
+  if (!benchmark::parseArguments(argc, argv, settings)) {
+    benchmark::usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // The synthetic scans are checked after the warm-up ones
+  settings.scans += c_iWarmUpTelegrams;
+  benchmark::TelegramStream stream;
+  if (!benchmark::loadTelegrams(settings, stream)) {
+    return EXIT_FAILURE;
+  }
+  if (stream.size() <= c_iWarmUpTelegrams) {
+    std::fprintf(stderr, "More than %zu telegrams are needed\n", c_iWarmUpTelegrams);
+    return EXIT_FAILURE;
+  }
+
+  int master, slave;
+  char name[256];
+  if (openpty(&master, &slave, name, nullptr, nullptr) != 0) {
+    std::perror("openpty");
+    return EXIT_FAILURE;
+  }
+
+  rclcpp::init(0, nullptr);
+
+  // The timers of the driver never run, as the node is not spun
+  rclcpp::NodeOptions options;
+  options.parameter_overrides(
+    {rclcpp::Parameter("port", std::string(name)),
+      rclcpp::Parameter("acquisition_mode", "timer"),
+      rclcpp::Parameter("latency_stats", true),
+      rclcpp::Parameter("publish_point_cloud", true),
+      rclcpp::Parameter("active_fields", std::vector<int64_t>{1, 2, 3, 4, 5})});
+  auto driver = std::make_shared<CheckedSickS300>(options);
+  if (driver->configure().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE ||
+    driver->activate().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
+  {
+    std::fprintf(stderr, "The driver cannot be activated on %s\n", name);
+    rclcpp::shutdown();
+    return EXIT_FAILURE;
+  }
+
+  bool ok = true;
+  size_t allocations = 0, telegrams_with_allocations = 0;
+  unsigned int first_telegram = driver->getReceivedTelegrams();
+  for (size_t i = 0; i < stream.size() && ok; i++) {
+    ssize_t written = write(master, stream.telegram(i), stream.lengths[i]);
+    if (written != static_cast<ssize_t>(stream.lengths[i])) {
+      std::perror("write");
+      ok = false;
+      break;
+    }
+
+    size_t first_allocation = getAllocationCount();
+    if (!driver->receive(first_telegram + static_cast<unsigned int>(i) + 1)) {
+      std::fprintf(stderr, "The telegram %zu was not received\n", i);
+      ok = false;
+    }
+    size_t telegram_allocations = getAllocationCount() - first_allocation;
+
+    if (i >= c_iWarmUpTelegrams && telegram_allocations > 0) {
+      if (telegrams_with_allocations < 10) {
+        std::printf("telegram %zu: %zu allocations\n", i, telegram_allocations);
+      }
+      allocations += telegram_allocations;
+      telegrams_with_allocations++;
+    }
+  }
+
+  size_t checked = stream.size() - c_iWarmUpTelegrams;
+  std::printf(
+    "%zu telegrams checked, %zu allocations in %zu of them\n", checked, allocations,
+    telegrams_with_allocations);
+
+  driver->deactivate();
+  driver->cleanup();
+  driver.reset();
+  rclcpp::shutdown();
+
+  close(slave);
+  close(master);
+  return ok && allocations == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
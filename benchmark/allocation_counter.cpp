@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The allocator functions of glibc are interposed and forwarded to their __libc_
+// implementations, which are exported for this purpose.
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "allocation_counter.hpp"
+
+namespace
+{
+
+// Constant initialized and in the static TLS block of the executable, so it is reached
+// without calling the allocator again
+thread_local size_t g_allocations = 0;
+
+inline void count()
+{
+  g_allocations++;
+}
+
+}  // namespace
+
+size_t getAllocationCount()
+{
+  return g_allocations;
+}
+
+extern "C" {
+
+void * __libc_malloc(size_t size);
+void * __libc_calloc(size_t count, size_t size);
+void * __libc_realloc(void * pointer, size_t size);
+void * __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void * pointer);
+
+void * malloc(size_t size) __THROW
+{
+  count();
+  return __libc_malloc(size);
+}
+
+void * calloc(size_t count_, size_t size) __THROW
+{
+  count();
+  return __libc_calloc(count_, size);
+}
+
+void * realloc(void * pointer, size_t size) __THROW
+{
+  count();
+  return __libc_realloc(pointer, size);
+}
+
+void free(void * pointer) __THROW
+{
+  __libc_free(pointer);
+}
+
+void * memalign(size_t alignment, size_t size) __THROW
+{
+  count();
+  return __libc_memalign(alignment, size);
+}
+
+void * aligned_alloc(size_t alignment, size_t size) __THROW
+{
+  count();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void ** pointer, size_t alignment, size_t size) __THROW
+{
+  count();
+  *pointer = __libc_memalign(alignment, size);
+  return *pointer != nullptr ? 0 : ENOMEM;
+}
+
+}  // extern "C"
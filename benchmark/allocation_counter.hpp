@@ -0,0 +1,30 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCHMARK__ALLOCATION_COUNTER_HPP_
+#define BENCHMARK__ALLOCATION_COUNTER_HPP_
+
+#include <stddef.h>
+
+/**
+ * Number of heap allocations made by the calling thread so far.
+ *
+ * allocation_counter.cpp replaces malloc() and its variants, so every allocation is
+ * counted, including the ones of operator new and of the C libraries of ROS. Only the
+ * executables linking it are affected. Each thread has its own count, so the threads of
+ * the middleware and of the executors do not add to the count of the measured code.
+ */
+size_t getAllocationCount();
+
+#endif  // BENCHMARK__ALLOCATION_COUNTER_HPP_
@@ -0,0 +1,163 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCHMARK__BENCHMARK_UTILS_HPP_
+#define BENCHMARK__BENCHMARK_UTILS_HPP_
+
+// C++
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "sicks300_ros2/common/SerialCapture.hpp"
+#include "sicks300_ros2/common/TelegramFramer.hpp"
+#include "sicks300_ros2/common/TelegramGenerator.hpp"
+
+namespace benchmark
+{
+
+// Received bytes and the telegrams found in them
+struct TelegramStream
+{
+  std::vector<unsigned char> bytes;
+  std::vector<size_t> starts;
+  std::vector<size_t> lengths;
+
+  size_t size() const {return starts.size();}
+  const unsigned char * telegram(size_t i) const {return bytes.data() + starts[i];}
+};
+
+// Input of the benchmarks, given on the command line
+struct Settings
+{
+  const char * capture = nullptr;
+  TelegramGenerator::Protocol protocol = TelegramGenerator::PROTOCOL_0301;
+  size_t scans = 10000;
+};
+
+inline void usage(const char * name)
+{
+  std::printf(
+    "Usage: %s [--capture FILE] [--protocol 0102|0301|0301-fields] [--scans N]\n"
+    "  Runs on the telegrams of a capture recorded by the driver, or on N synthetic\n"
+    "  telegrams of the given protocol (default 0301, 10000 scans).\n", name);
+}
+
+inline bool parseArguments(int argc, char ** argv, Settings & settings)
+{
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 < argc && std::strcmp(argv[i], "--capture") == 0) {
+      settings.capture = argv[++i];
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--protocol") == 0) {
+      if (!TelegramGenerator::parseProtocol(argv[++i], settings.protocol)) {return false;}
+    } else if (i + 1 < argc && std::strcmp(argv[i], "--scans") == 0) {
+      settings.scans = std::strtoul(argv[++i], nullptr, 10);
+    } else {
+      return false;
+    }
+  }
+  return settings.scans > 0;
+}
+
+// Frames the bytes, the index of a capture may be missing
+inline void findTelegrams(TelegramStream & stream)
+{
+  TelegramFramer framer;
+  size_t start, length;
+  while (framer.next(stream.bytes.data(), stream.bytes.size(), start, length)) {
+    stream.starts.push_back(start);
+    stream.lengths.push_back(length);
+  }
+}
+
+inline bool loadTelegrams(const Settings & settings, TelegramStream & stream)
+{
+  if (settings.capture != nullptr) {
+    CaptureReader capture;
+    if (!capture.open(settings.capture)) {
+      std::fprintf(stderr, "%s is not a capture\n", settings.capture);
+      return false;
+    }
+    for (const auto & chunk : capture.getChunks()) {
+      stream.bytes.insert(stream.bytes.end(), chunk.data, chunk.data + chunk.size);
+    }
+    findTelegrams(stream);
+    if (stream.size() == 0) {
+      std::fprintf(stderr, "%s has no telegram\n", settings.capture);
+      return false;
+    }
+    return true;
+  }
+
+  TelegramGenerator::Options options;
+  options.protocol = settings.protocol;
+  TelegramGenerator generator(options);
+  for (size_t i = 0; i < settings.scans; i++) {
+    const std::vector<unsigned char> & telegram = generator.next();
+    stream.starts.push_back(stream.bytes.size());
+    stream.lengths.push_back(telegram.size());
+    stream.bytes.insert(stream.bytes.end(), telegram.begin(), telegram.end());
+  }
+  return true;
+}
+
+// Time and heap allocations per scan of a stage
+struct Result
+{
+  double ns_per_scan;
+  double allocations_per_scan;
+};
+
+/**
+ * Runs the stage once to warm up the caches and the buffers, then measures a second run.
+ * @param scans number of scans processed by one run of the stage
+ */
+template<typename Stage>
+Result measure(size_t scans, Stage && stage)
+{
+  stage();
+
+  size_t allocations = getAllocationCount();
+  auto start = std::chrono::steady_clock::now();
+  stage();
+  auto stop = std::chrono::steady_clock::now();
+
+  Result result;
+  result.ns_per_scan = std::chrono::duration<double, std::nano>(stop - start).count() / scans;
+  result.allocations_per_scan =
+    static_cast<double>(getAllocationCount() - allocations) / scans;
+  return result;
+}
+
+inline void report(const char * stage, const Result & result)
+{
+  std::printf(
+    "%-22s %10.1f ns/scan %8.2f allocations/scan\n", stage, result.ns_per_scan,
+    result.allocations_per_scan);
+}
+
+// Keeps a result alive, so the stage is not optimized away
+template<typename T>
+inline void keep(const T & value)
+{
+  volatile T sink = value;
+  (void)sink;
+}
+
+}  // namespace benchmark
+
+#endif  // BENCHMARK__BENCHMARK_UTILS_HPP_
@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks that every CRC-16 engine supported by the CPU agrees with the bytewise
+// reference on random inputs and reports the throughput of each one.
+//
+// Usage: crc16_benchmark [iterations]
+
+// C++
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "sicks300_ros2/common/Crc16.hpp"
+
+namespace
+{
+
+bool checkEngine(Crc16::Engine engine, std::mt19937 & rng)
+{
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<size_t> length(0, 4096);
+  std::vector<uint8_t> data(4096 + 16);
+  for (auto & d : data) {
+    d = static_cast<uint8_t>(byte(rng));
+  }
+
+  for (int i = 0; i < 20000; i++) {
+    size_t size = length(rng);
+    size_t offset = static_cast<size_t>(byte(rng)) % 16;
+    uint16_t init = static_cast<uint16_t>(byte(rng) << 8 | byte(rng));
+    uint16_t expected = Crc16::update(Crc16::BYTEWISE, init, data.data() + offset, size);
+    uint16_t crc = Crc16::update(engine, init, data.data() + offset, size);
+    if (crc != expected) {
+      std::printf(
+        "%s: mismatch for %zu bytes at offset %zu: 0x%04x instead of 0x%04x\n",
+        Crc16::getName(engine), size, offset, crc, expected);
+      return false;
+    }
+  }
+  return true;
+}
+
+double measure(Crc16::Engine engine, const std::vector<uint8_t> & data, int iterations)
+{
+  uint16_t crc = 0xFFFF;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    crc = Crc16::update(engine, crc, data.data(), data.size());
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  // Keep the result alive so the loop is not optimized away
+  volatile uint16_t sink = crc;
+  (void)sink;
+
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  return static_cast<double>(data.size()) * iterations / ns;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+  std::mt19937 rng(42);
+
+  // A telegram with 541 measurements and a long capture
+  const size_t sizes[] = {1104, 65536};
+
+  std::printf("best engine: %s\n", Crc16::getName(Crc16::getBestEngine()));
+
+  bool ok = true;
+  for (int e = 0; e < Crc16::NUM_ENGINES; e++) {
+    Crc16::Engine engine = static_cast<Crc16::Engine>(e);
+    if (!Crc16::isSupported(engine)) {
+      std::printf("%-12s not supported\n", Crc16::getName(engine));
+      continue;
+    }
+    if (!checkEngine(engine, rng)) {
+      ok = false;
+      continue;
+    }
+
+    for (size_t size : sizes) {
+      std::vector<uint8_t> data(size);
+      for (auto & d : data) {
+        d = static_cast<uint8_t>(rng());
+      }
+      int n = static_cast<int>(iterations * 1104 / size) + 1;
+      std::printf(
+        "%-12s %6zu bytes: %6.3f bytes/ns\n", Crc16::getName(engine), size,
+        measure(engine, data, n));
+    }
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
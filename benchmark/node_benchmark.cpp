@@ -0,0 +1,193 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the ROS stages of the scan pipeline: SickS300::handleScan, which fills and
+// publishes the LaserScan and updates the diagnostics, and the ScanFilter callback, reached
+// through an intra-process subscription.
+//
+// The driver is configured on a pseudo-terminal, so no scanner is needed; the telegrams
+// are decoded into its message directly.
+//
+// Usage: node_benchmark [--capture FILE] [--protocol 0102|0301|0301-fields] [--scans N]
+
+// C
+#include <pty.h>
+#include <unistd.h>
+
+// C++
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// ROS
+#include "lifecycle_msgs/msg/state.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "sensor_msgs/msg/laser_scan.hpp"
+
+#include "benchmark_utils.hpp"
+#include "sicks300_ros2/scan_filter.hpp"
+#include "sicks300_ros2/sicks300.hpp"
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+// Exposes the steps of the driver that are not reachable from outside
+class BenchmarkSickS300 : public sicks300_ros2::SickS300
+{
+public:
+  explicit BenchmarkSickS300(const rclcpp::NodeOptions & options)
+  : SickS300(options)
+  {
+  }
+
+  bool decode(
+    const unsigned char * telegram, size_t length,
+    const ScannerSickS300::ScanGeometry * & geometry, unsigned int & scan_number)
+  {
+    scanner_.feed(telegram, length);
+    return scanner_.nextScan(
+      laser_scan_->ranges, laser_scan_->intensities, geometry, scan_number, inverted_, false);
+  }
+
+  void publish(const ScannerSickS300::ScanGeometry & geometry, unsigned int scan_number)
+  {
+    handleScan(geometry, scan_number);
+  }
+
+  const sensor_msgs::msg::LaserScan & getMessage() const {return *laser_scan_;}
+};
+
+// Decodes every telegram untimed and measures the publication of the scan
+benchmark::Result measureDriver(
+  BenchmarkSickS300 & driver, const benchmark::TelegramStream & stream)
+{
+  benchmark::Result result = {0.0, 0.0};
+  for (int run = 0; run < 2; run++) {
+    Clock::duration time(0);
+    size_t allocations = 0, scans = 0;
+    const ScannerSickS300::ScanGeometry * geometry;
+    unsigned int scan_number;
+
+    for (size_t i = 0; i < stream.size(); i++) {
+      if (!driver.decode(stream.telegram(i), stream.lengths[i], geometry, scan_number)) {
+        continue;
+      }
+      size_t first_allocation = getAllocationCount();
+      Clock::time_point start = Clock::now();
+      driver.publish(*geometry, scan_number);
+      time += Clock::now() - start;
+      allocations += getAllocationCount() - first_allocation;
+      scans++;
+    }
+
+    if (scans > 0) {
+      result.ns_per_scan = std::chrono::duration<double, std::nano>(time).count() / scans;
+      result.allocations_per_scan = static_cast<double>(allocations) / scans;
+    }
+  }
+  return result;
+}
+
+// Publishes copies of the scan to the filter and runs its callback
+benchmark::Result measureFilter(const sensor_msgs::msg::LaserScan & scan, size_t scans)
+{
+  rclcpp::NodeOptions filter_options;
+  filter_options.use_intra_process_comms(true);
+  filter_options.parameter_overrides(
+    {rclcpp::Parameter("lower_angle", -2.05), rclcpp::Parameter("upper_angle", 2.22)});
+  auto filter = std::make_shared<sicks300_ros2::ScanFilter>(filter_options);
+
+  auto source = std::make_shared<rclcpp::Node>(
+    "scan_source", rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher =
+    source->create_publisher<sensor_msgs::msg::LaserScan>("scan", rclcpp::SensorDataQoS());
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(filter);
+
+  benchmark::Result result = {0.0, 0.0};
+  for (int run = 0; run < 2; run++) {
+    Clock::duration time(0);
+    size_t allocations = 0;
+    for (size_t i = 0; i < scans; i++) {
+      // The copy stands for the message of the driver, it is not measured
+      auto message = std::make_unique<sensor_msgs::msg::LaserScan>(scan);
+      size_t first_allocation = getAllocationCount();
+      Clock::time_point start = Clock::now();
+      publisher->publish(std::move(message));
+      executor.spin_some();
+      time += Clock::now() - start;
+      allocations += getAllocationCount() - first_allocation;
+    }
+    result.ns_per_scan = std::chrono::duration<double, std::nano>(time).count() / scans;
+    result.allocations_per_scan = static_cast<double>(allocations) / scans;
+  }
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  benchmark::Settings settings;
+  if (!benchmark::parseArguments(argc, argv, settings)) {
+    benchmark::usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  benchmark::TelegramStream stream;
+  if (!benchmark::loadTelegrams(settings, stream)) {
+    return EXIT_FAILURE;
+  }
+
+  int master, slave;
+  char name[256];
+  if (openpty(&master, &slave, name, nullptr, nullptr) != 0) {
+    std::perror("openpty");
+    return EXIT_FAILURE;
+  }
+
+  rclcpp::init(0, nullptr);
+
+  rclcpp::NodeOptions options;
+  options.parameter_overrides({rclcpp::Parameter("port", std::string(name))});
+  auto driver = std::make_shared<BenchmarkSickS300>(options);
+  if (driver->configure().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE ||
+    driver->activate().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
+  {
+    std::fprintf(stderr, "The driver cannot be activated on %s\n", name);
+    rclcpp::shutdown();
+    return EXIT_FAILURE;
+  }
+
+  std::printf("%zu telegrams, %zu bytes\n", stream.size(), stream.bytes.size());
+  benchmark::report("SickS300::handleScan", measureDriver(*driver, stream));
+
+  // The message of the driver holds the last scan decoded
+  benchmark::report(
+    "ScanFilter (intra)", measureFilter(driver->getMessage(), stream.size()));
+
+  driver->deactivate();
+  driver->cleanup();
+  driver.reset();
+  rclcpp::shutdown();
+
+  close(slave);
+  close(master);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the stages of the scan pipeline of scanner_serial, from the received bytes to
+// the decoded ranges, on synthetic telegrams or on the telegrams of a capture.
+//
+// Usage: pipeline_benchmark [--capture FILE] [--protocol 0102|0301|0301-fields] [--scans N]
+
+// C++
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "sicks300_ros2/common/Crc16.hpp"
+#include "sicks300_ros2/common/ScanPoints.hpp"
+#include "sicks300_ros2/common/ScannerSickS300.hpp"
+#include "sicks300_ros2/common/TelegramFramer.hpp"
+#include "sicks300_ros2/common/TelegramS300.hpp"
+
+namespace
+{
+
+// Telegrams fed to the scanner before reading them, less than MAX_PENDING_TELEGRAMS
+const size_t c_iBatchSize = 16;
+
+typedef std::chrono::steady_clock Clock;
+
+void configureFields(ScannerSickS300 & scanner)
+{
+  ScannerSickS300::ParamType param;
+  param.dScale = 0.01;
+  param.dStartAngle = -2.36;
+  param.dStopAngle = 2.36;
+  for (int field = 1; field <= 5; field++) {
+    param.range_field = field;
+    scanner.setRangeField(field, param);
+  }
+}
+
+// Feeds the telegrams by batches and decodes them, measuring both steps apart
+void measureScanner(const benchmark::TelegramStream & stream)
+{
+  ScannerSickS300 scanner;
+  configureFields(scanner);
+
+  std::vector<float> ranges, intensities;
+  const ScannerSickS300::ScanGeometry * geometry;
+  unsigned int scan_number;
+
+  for (int run = 0; run < 2; run++) {
+    Clock::duration feed_time(0), decode_time(0);
+    size_t feed_allocations = 0, decode_allocations = 0, scans = 0;
+
+    for (size_t first = 0; first < stream.size(); first += c_iBatchSize) {
+      size_t last = first + c_iBatchSize < stream.size() ? first + c_iBatchSize : stream.size();
+      size_t allocations = getAllocationCount();
+      Clock::time_point start = Clock::now();
+      for (size_t i = first; i < last; i++) {
+        scanner.feed(stream.telegram(i), stream.lengths[i]);
+      }
+      Clock::time_point fed = Clock::now();
+      size_t fed_allocations = getAllocationCount();
+      while (scanner.nextScan(ranges, intensities, geometry, scan_number, false, false)) {
+        scans++;
+      }
+      Clock::time_point decoded = Clock::now();
+
+      feed_time += fed - start;
+      decode_time += decoded - fed;
+      feed_allocations += fed_allocations - allocations;
+      decode_allocations += getAllocationCount() - fed_allocations;
+    }
+
+    // The first run warms up the buffers
+    if (run == 0) {continue;}
+    if (scans == 0) {
+      std::printf("No scan decoded\n");
+      return;
+    }
+
+    benchmark::Result result;
+    result.ns_per_scan = std::chrono::duration<double, std::nano>(feed_time).count() / scans;
+    result.allocations_per_scan = static_cast<double>(feed_allocations) / scans;
+    benchmark::report("feed (copy, frame)", result);
+    result.ns_per_scan = std::chrono::duration<double, std::nano>(decode_time).count() / scans;
+    result.allocations_per_scan = static_cast<double>(decode_allocations) / scans;
+    benchmark::report("nextScan (convert)", result);
+  }
+}
+
+// Converts the decoded scans to points with each engine, checking it against the scalar one
+void measureScanPoints(const benchmark::TelegramStream & stream)
+{
+  ScannerSickS300 scanner;
+  configureFields(scanner);
+
+  std::vector<std::vector<float>> ranges, intensities;
+  std::vector<const ScannerSickS300::ScanGeometry *> geometries;
+  std::vector<float> scan_ranges, scan_intensities;
+  const ScannerSickS300::ScanGeometry * geometry;
+  unsigned int scan_number;
+  for (size_t i = 0; i < stream.size(); i++) {
+    scanner.feed(stream.telegram(i), stream.lengths[i]);
+    while (scanner.nextScan(
+        scan_ranges, scan_intensities, geometry, scan_number, false, false))
+    {
+      ranges.push_back(scan_ranges);
+      intensities.push_back(scan_intensities);
+      geometries.push_back(geometry);
+    }
+  }
+  if (geometries.empty()) {return;}
+
+  auto convert = [&](ScanPoints::Engine engine, size_t scan, std::vector<float> & points) {
+      const ScannerSickS300::ScanGeometry & scan_geometry = *geometries[scan];
+      points.resize(ranges[scan].size() * ScanPoints::POINT_FIELDS);
+      return ScanPoints::convert(
+        engine, ranges[scan].data(), intensities[scan].data(), scan_geometry.vfSin.data(),
+        scan_geometry.vfCos.data(), ranges[scan].size(), 0.001f, 29.5f, points.data());
+    };
+
+  std::vector<float> expected, points;
+  for (int engine = 0; engine < ScanPoints::NUM_ENGINES; engine++) {
+    ScanPoints::Engine scan_engine = static_cast<ScanPoints::Engine>(engine);
+    if (!ScanPoints::isSupported(scan_engine)) {continue;}
+
+    size_t mismatches = 0;
+    for (size_t scan = 0; scan < geometries.size(); scan++) {
+      size_t expected_count = convert(ScanPoints::SCALAR, scan, expected);
+      size_t count = convert(scan_engine, scan, points);
+      mismatches += count != expected_count || std::memcmp(
+        points.data(), expected.data(), count * ScanPoints::POINT_FIELDS * sizeof(float)) != 0;
+    }
+    if (mismatches > 0) {
+      std::printf(
+        "ScanPoints %s: %zu scans differ\n", ScanPoints::getName(scan_engine), mismatches);
+    }
+
+    std::string name = std::string("ScanPoints ") + ScanPoints::getName(scan_engine);
+    benchmark::report(
+      name.c_str(), benchmark::measure(
+        geometries.size(), [&]() {
+          size_t total = 0;
+          for (size_t scan = 0; scan < geometries.size(); scan++) {
+            total += convert(scan_engine, scan, points);
+          }
+          benchmark::keep(total);
+        }));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  benchmark::Settings settings;
+  if (!benchmark::parseArguments(argc, argv, settings)) {
+    benchmark::usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  benchmark::TelegramStream stream;
+  if (!benchmark::loadTelegrams(settings, stream)) {
+    return EXIT_FAILURE;
+  }
+  size_t scans = stream.size();
+  std::printf(
+    "%zu telegrams, %zu bytes, CRC engine %s\n", scans, stream.bytes.size(),
+    Crc16::getName(Crc16::getBestEngine()));
+
+  benchmark::report(
+    "createCRC", benchmark::measure(
+      scans, [&]() {
+        uint16_t crc = 0;
+        for (size_t i = 0; i < scans; i++) {
+          // The reply header and the CRC itself are not part of the CRC
+          crc ^= TelegramParser::updateCRC(0xFFFF, stream.telegram(i) + 4, stream.lengths[i] - 6);
+        }
+        benchmark::keep(crc);
+      }));
+
+  benchmark::report(
+    "TelegramFramer::next", benchmark::measure(
+      scans, [&]() {
+        TelegramFramer framer;
+        size_t start, length, found = 0;
+        while (framer.next(stream.bytes.data(), stream.bytes.size(), start, length)) {
+          found++;
+        }
+        benchmark::keep(found);
+      }));
+
+  TelegramParser parser;
+  benchmark::report(
+    "parseFrame", benchmark::measure(
+      scans, [&]() {
+        size_t valid = 0;
+        for (size_t i = 0; i < scans; i++) {
+          valid += parser.parseFrame(stream.telegram(i), stream.lengths[i], false);
+        }
+        benchmark::keep(valid);
+      }));
+
+  std::vector<int> values;
+  benchmark::report(
+    "parseFrame+readDistRaw", benchmark::measure(
+      scans, [&]() {
+        size_t points = 0;
+        for (size_t i = 0; i < scans; i++) {
+          parser.parseFrame(stream.telegram(i), stream.lengths[i], false);
+          parser.readDistRaw(stream.telegram(i), values, false);
+          points += values.size();
+        }
+        benchmark::keep(points);
+      }));
+
+  measureScanner(stream);
+  measureScanPoints(stream);
+
+  return EXIT_SUCCESS;
+}
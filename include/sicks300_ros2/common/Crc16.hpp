@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__CRC16_HPP_
+#define SICKS300_ROS2__COMMON__CRC16_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC-16/CCITT (polynomial 0x1021, not reflected) used by the S300 telegrams.
+ *
+ * Several implementations are provided, all giving the same result:
+ * - BYTEWISE: one table lookup per byte, the reference implementation.
+ * - SLICE_BY_8: eight table lookups for every 8 bytes.
+ * - CLMUL: folding of 16 byte blocks with carry-less multiplications (PCLMULQDQ).
+ *
+ * update() uses the fastest engine supported by the CPU, detected once at runtime.
+ */
+class Crc16
+{
+public:
+  enum Engine {BYTEWISE, SLICE_BY_8, CLMUL, NUM_ENGINES};
+
+  /**
+   * Continues the CRC over size bytes with the fastest engine available.
+   * @param crc CRC of the previous data, 0xFFFF to start a new one
+   */
+  static uint16_t update(uint16_t crc, const uint8_t * data, size_t size)
+  {
+    return getUpdateFunction()(crc, data, size);
+  }
+
+  /**
+   * Continues the CRC over size bytes with the given engine, which must be supported.
+   */
+  static uint16_t update(Engine engine, uint16_t crc, const uint8_t * data, size_t size);
+
+  /// Whether the CPU supports the engine.
+  static bool isSupported(Engine engine);
+
+  /// Engine used by update().
+  static Engine getBestEngine();
+
+  static const char * getName(Engine engine);
+
+private:
+  typedef uint16_t (* UpdateFunction)(uint16_t, const uint8_t *, size_t);
+
+  static UpdateFunction getUpdateFunction();
+};
+
+#endif  // SICKS300_ROS2__COMMON__CRC16_HPP_
@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__LATENCYHISTOGRAM_HPP_
+#define SICKS300_ROS2__COMMON__LATENCYHISTOGRAM_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+
+/**
+ * Histogram of latencies in nanoseconds with a bounded relative error, as HdrHistogram.
+ *
+ * Values below 32 ns have their own bucket. Above, every power of two is split into 32
+ * buckets, so a value is known within 1/32 (3%) whatever its magnitude. Values of
+ * 2^32 ns (4.3 s) or more are counted in the last bucket.
+ *
+ * record() is wait free and may be called from one thread while another one calls
+ * collect(), without locks: the buckets are atomic counters.
+ */
+class LatencyHistogram
+{
+public:
+  enum
+  {
+    SUB_BUCKET_BITS = 5,
+    SUB_BUCKETS = 1 << SUB_BUCKET_BITS,
+    MAX_BITS = 32,
+    NUM_BUCKETS = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS
+  };
+
+  struct Summary
+  {
+    uint64_t count;
+    int64_t p50;                 // median in ns
+    int64_t p99;                 // 99th percentile in ns
+    int64_t max;                 // exact maximum in ns
+  };
+
+  LatencyHistogram();
+
+  /// Adds a latency, negative ones are counted as 0.
+  void record(int64_t value_ns);
+
+  /// Summarizes the latencies recorded since the previous call and clears them.
+  Summary collect();
+
+  /// Host time in nanoseconds used for the latencies.
+  static int64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+private:
+  static size_t getBucket(uint64_t value);
+  // Middle of the range of values of a bucket
+  static int64_t getBucketValue(size_t bucket);
+
+  std::atomic<uint32_t> counts_[NUM_BUCKETS];
+  std::atomic<int64_t> max_;
+};
+
+#endif  // SICKS300_ROS2__COMMON__LATENCYHISTOGRAM_HPP_
@@ -0,0 +1,54 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__REALTIME_HPP_
+#define SICKS300_ROS2__COMMON__REALTIME_HPP_
+
+#include <pthread.h>
+#include <stddef.h>
+
+#include <vector>
+
+/**
+ * Settings of the operating system that keep the acquisition thread from being delayed by
+ * the other processes of a loaded machine.
+ *
+ * Every function returns 0 if the setting was applied, otherwise the error number, e.g.
+ * EPERM when the process lacks CAP_SYS_NICE or the rtprio and memlock limits are too low.
+ */
+class RealTime
+{
+public:
+  /**
+   * Runs a thread with the SCHED_FIFO policy at the given priority.
+   * @param priority 1 (lowest) to 99, 0 to go back to the default policy
+   */
+  static int setPriority(pthread_t thread, int priority);
+
+  /**
+   * Restricts a thread to a set of CPUs.
+   * @param cpus indexes of the CPUs, empty to allow every CPU
+   */
+  static int setAffinity(pthread_t thread, const std::vector<int> & cpus);
+
+  /**
+   * Locks the current and future pages of the process in memory, so a page fault never
+   * stops the acquisition, and touches stack_size bytes of the stack of the caller.
+   * The heap is no longer given back to the system, so freed blocks stay locked.
+   * It applies to the whole process, e.g. every node of a component container.
+   */
+  static int lockMemory(size_t stack_size);
+};
+
+#endif  // SICKS300_ROS2__COMMON__REALTIME_HPP_
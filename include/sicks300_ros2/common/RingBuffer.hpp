@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__RINGBUFFER_HPP_
+#define SICKS300_ROS2__COMMON__RINGBUFFER_HPP_
+
+#include <stddef.h>
+
+#include <vector>
+
+/**
+ * Byte ring buffer for the serial receive path.
+ *
+ * The capacity is a power of two and the positions are free running counters, so they
+ * stay valid while data is added and removed. The first bytes of the storage are mirrored
+ * after its end: any view of up to 'mirror' bytes is contiguous, even across the wrap,
+ * and can be handed to the parser without copying it first.
+ */
+class RingBuffer
+{
+public:
+  /**
+   * @param capacity number of bytes, rounded up to a power of two
+   * @param mirror size of the longest view that has to be contiguous
+   */
+  RingBuffer(size_t capacity, size_t mirror);
+
+  /// Removes all the bytes.
+  void clear() {tail_ = head_;}
+
+  /// Position of the oldest byte.
+  size_t begin() const {return tail_;}
+
+  /// Position after the newest byte.
+  size_t end() const {return head_;}
+
+  /// Number of bytes stored.
+  size_t size() const {return head_ - tail_;}
+
+  /// Number of bytes that can still be written.
+  size_t space() const {return capacity_ - size();}
+
+  size_t capacity() const {return capacity_;}
+
+  /**
+   * Returns the contiguous free region after the newest byte.
+   * @param length size of the region in bytes
+   */
+  unsigned char * writeView(size_t & length);
+
+  /**
+   * Returns the whole free region after the newest byte, in two parts when it wraps
+   * around the end of the storage, so it can be filled with a single readv().
+   * @param length size of the first part in bytes
+   * @param wrapped start of the storage, where the second part is
+   * @param wrapped_length size of the second part in bytes, 0 if the region does not wrap
+   */
+  unsigned char * writeView(size_t & length, unsigned char * & wrapped, size_t & wrapped_length);
+
+  /**
+   * Appends count bytes written through writeView(), which may cover both parts.
+   */
+  void commit(size_t count);
+
+  /**
+   * Copies data at the end of the buffer.
+   * @return number of bytes copied, less than length if the buffer is full
+   */
+  size_t write(const unsigned char * data, size_t length);
+
+  /**
+   * Returns a contiguous view of the stored bytes starting at position.
+   * @param position position between begin() and end()
+   * @param length number of bytes of the view, at least min(mirror, end() - position)
+   */
+  const unsigned char * readView(size_t position, size_t & length) const;
+
+  /**
+   * Removes the bytes before position.
+   */
+  void release(size_t position) {tail_ = position;}
+
+private:
+  std::vector<unsigned char> data_;
+  size_t capacity_, mask_, mirror_;
+  size_t head_, tail_;
+};
+
+#endif  // SICKS300_ROS2__COMMON__RINGBUFFER_HPP_
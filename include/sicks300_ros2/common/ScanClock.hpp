@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__SCANCLOCK_HPP_
+#define SICKS300_ROS2__COMMON__SCANCLOCK_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+/**
+ * Model of the scanner clock, mapping the scan numbers of the telegrams to host time.
+ *
+ * The scanner increments the scan number once per scan with its own oscillator, so the
+ * arrival time of a scan is a linear function of its scan number plus the transmission
+ * and scheduling delays, which are never negative. A line is fitted by least squares over
+ * a sliding window of (scan number, arrival time) samples and then shifted down to the
+ * earliest arrival of the window, which is the sample with the least delay. Samples
+ * arriving much later than the model predicts are rejected as jitter.
+ *
+ * The model is restarted when the scan number jumps (scanner restart), when the fitted
+ * period is far from the nominal one or when too many samples are rejected in a row
+ * (host clock jump).
+ */
+class ScanClock
+{
+public:
+  enum
+  {
+    MIN_SAMPLES = 16,            // samples needed before the model is used
+    MAX_REJECTED = 25,           // samples rejected in a row before restarting
+    MAX_SCAN_GAP = 1000          // larger jumps of the scan number restart the model
+  };
+
+  /**
+   * @param nominal_period scan cycle time in seconds given by the documentation
+   * @param window number of samples used for the fit, 256 scans are about 10 seconds
+   */
+  explicit ScanClock(double nominal_period = 0.04, size_t window = 256);
+
+  /// Drops every sample, the model is not ready until MIN_SAMPLES are added again.
+  void reset();
+
+  void setNominalPeriod(double nominal_period) {nominal_period_ = nominal_period; reset();}
+
+  /**
+   * Adds the arrival time of a scan.
+   * @param scan_number scan number of the newest telegram received
+   * @param arrival_ns host time in nanoseconds at which it was received
+   * @return false if the sample was rejected as jitter
+   */
+  bool update(unsigned int scan_number, int64_t arrival_ns);
+
+  /// Whether enough samples were added to use toTime().
+  bool isReady() const {return num_samples_ >= MIN_SAMPLES;}
+
+  /**
+   * Returns the host time in nanoseconds at which the scan would have been received
+   * without any delay.
+   */
+  int64_t toTime(unsigned int scan_number) const;
+
+  /// Scan cycle time in seconds measured with the host clock.
+  double getPeriod() const {return slope_;}
+
+  /// Root mean square of the arrival times around the fitted line, in seconds.
+  double getJitter() const {return jitter_;}
+
+  /// Number of samples rejected since the model was created.
+  unsigned int getRejected() const {return rejected_;}
+
+private:
+  struct Sample
+  {
+    double ticks;              // scans since the origin
+    double time;               // seconds since the origin
+  };
+
+  void fit();
+
+  double nominal_period_;
+  std::vector<Sample> samples_;  // ring of the last samples
+  size_t num_samples_, next_sample_;
+  unsigned int last_scan_number_;
+  double last_ticks_;
+  int64_t origin_ns_;
+  double intercept_, slope_, envelope_, jitter_;
+  unsigned int rejected_, rejected_in_row_;
+};
+
+#endif  // SICKS300_ROS2__COMMON__SCANCLOCK_HPP_
@@ -0,0 +1,89 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__SCANPOINTS_HPP_
+#define SICKS300_ROS2__COMMON__SCANPOINTS_HPP_
+
+#include <stddef.h>
+
+/**
+ * Conversion of the decoded ranges of a scan to cartesian points.
+ *
+ * Each point is written as four floats: x, y, z (always 0) and intensity, the layout of
+ * the PointCloud2 published by the driver. The angles come from the sine and cosine tables
+ * of the scan geometry, so no trigonometric function is evaluated. The beams out of the
+ * valid range are dropped on the way, without branches: every point is stored and the
+ * output only advances past the valid ones.
+ *
+ * Several implementations are provided, all giving the same result:
+ * - SCALAR: one beam at a time, the reference implementation.
+ * - SSE: four beams at a time.
+ * - AVX2: eight beams at a time.
+ *
+ * convert() uses the fastest engine supported by the CPU, detected once at runtime.
+ */
+class ScanPoints
+{
+public:
+  enum Engine {SCALAR, SSE, AVX2, NUM_ENGINES};
+
+  enum
+  {
+    POINT_FIELDS = 4             // floats per point: x, y, z and intensity
+  };
+
+  /**
+   * Converts the beams whose range is within [range_min, range_max] with the fastest
+   * engine available.
+   * @param ranges distances in meters
+   * @param intensities intensities in arbitrary units
+   * @param sin_table sine of the angle of each beam
+   * @param cos_table cosine of the angle of each beam
+   * @param num_beams number of beams of the scan
+   * @param points output with room for POINT_FIELDS * num_beams floats
+   * @return number of points written
+   */
+  static size_t convert(
+    const float * ranges, const float * intensities, const float * sin_table,
+    const float * cos_table, size_t num_beams, float range_min, float range_max,
+    float * points)
+  {
+    return getConvertFunction()(
+      ranges, intensities, sin_table, cos_table, num_beams, range_min, range_max, points);
+  }
+
+  /**
+   * Converts the beams with the given engine, which must be supported.
+   */
+  static size_t convert(
+    Engine engine, const float * ranges, const float * intensities, const float * sin_table,
+    const float * cos_table, size_t num_beams, float range_min, float range_max,
+    float * points);
+
+  /// Whether the CPU supports the engine.
+  static bool isSupported(Engine engine);
+
+  /// Engine used by convert().
+  static Engine getBestEngine();
+
+  static const char * getName(Engine engine);
+
+private:
+  typedef size_t (* ConvertFunction)(
+    const float *, const float *, const float *, const float *, size_t, float, float, float *);
+
+  static ConvertFunction getConvertFunction();
+};
+
+#endif  // SICKS300_ROS2__COMMON__SCANPOINTS_HPP_
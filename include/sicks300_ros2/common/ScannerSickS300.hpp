@@ -21,11 +21,15 @@
 #include <math.h>
 #include <stdio.h>
 #include <iostream>
-#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "sicks300_ros2/common/LatencyHistogram.hpp"
+#include "sicks300_ros2/common/RingBuffer.hpp"
+#include "sicks300_ros2/common/SerialCapture.hpp"
 #include "sicks300_ros2/common/SerialIO.hpp"
+#include "sicks300_ros2/common/TelegramFramer.hpp"
 #include "sicks300_ros2/common/TelegramS300.hpp"
 
 /**
@@ -47,19 +51,59 @@ public:
     double dStopAngle;           // scan stop angle
   };
 
-  // storage container for received scanner data
-  struct ScanPolarType
+  // angles of the measurements of a field, computed once and shared by every scan
+  struct ScanGeometry
   {
-    double dr;             // distance //r;
-    double da;             // angle //a;
-    double di;             // intensity; //bool bGlare;
+    size_t iNumBeams;            // number of measurements per scan
+    double dAngleMin;            // angle of the first measurement
+    double dAngleMax;            // angle of the last measurement
+    double dAngleIncrement;      // angle between two measurements
+    std::vector<float> vfSin;    // sine of the angle of each measurement
+    std::vector<float> vfCos;    // cosine of the angle of each measurement
+  };
+
+  // reflector detected by the scanner, from a reflector telegram (0xCCCC)
+  struct Reflector
+  {
+    unsigned int iFirstBeam;     // first measurement on the reflector, in the order of the scans
+    unsigned int iLastBeam;      // last measurement on the reflector
+    double dAngle;               // angle of the center of the reflector
+    double dDistanceM;           // distance in meters
+  };
+
+  // reflectors of a scan
+  struct ReflectorData
+  {
+    unsigned int iScanNumber;
+    std::vector<Reflector> vReflectors;
+  };
+
+  // state of the inputs and outputs, from an I/O telegram (0xAAAA)
+  struct IoData
+  {
+    unsigned int iScanNumber;
+    std::vector<uint16_t> viWords;     // words after the type, as sent by the scanner
+  };
+
+  // host times in ns (LatencyHistogram::now()) of the steps of a scan, 0 if not measured
+  struct ScanTimes
+  {
+    int64_t iFirstByteNs;        // the first byte of the telegram was read
+    int64_t iCompleteNs;         // the last byte of the telegram was read
+    int64_t iCrcOkNs;            // the telegram was framed and its CRC checked
+    int64_t iDecodedNs;          // the measurements were converted
   };
 
   enum
   {
-    SCANNER_S300_READ_BUF_SIZE = 10000,
-    READ_BUF_SIZE = 10000,
-    WRITE_BUF_SIZE = 10000
+    READ_BUF_SIZE = 8192,               // receive ring buffer, must be a power of two
+    WRITE_BUF_SIZE = 10000,
+    MAX_PENDING_TELEGRAMS = 32,         // telegrams framed but not read yet
+    MAX_READ_TIMES = 64,                // reads remembered to find the first byte of a telegram
+    MAX_REFLECTORS = 64,                // reflectors kept without reallocating
+    MAX_IO_WORDS = 16,                  // I/O words kept without reallocating
+    MAX_FIELDS = 5,                     // measurement fields 1 to 5
+    DEFAULT_NUM_BEAMS = 541             // 270 degrees with 0.5 degrees resolution
   };
 
   // Constructor
@@ -72,7 +116,8 @@ public:
    * Opens serial port.
    * @param pcPort used "COMx" or "/dev/tty1"
    * @param iBaudRate baud rate
-   * @param iScanId the scanner id in the data header (7 by default)
+   * @param iScanId the scanner id in the data header (7 by default), the telegrams of
+   * other devices are dropped
    */
   bool open(const char * pcPort, int iBaudRate, int iScanId);
 
@@ -89,42 +134,258 @@ public:
   // whether the scanner is currently in Standby or not
   bool isInStandby() {return m_bInStandby;}
 
+  // whether the last read found the port closed or hung up, e.g. an unplugged adapter, so
+  // the next ones fail at once as well
+  bool isPortLost() const {return m_bPortLost;}
+
+  // marks the port as lost when its hang up is found without reading it
+  void markPortLost() {m_bPortLost = true;}
+
   void purgeScanBuf();
 
+  /**
+   * Waits until the serial port has new data to read, or was hung up.
+   * @param dTimeout maximum waiting time in seconds
+   * @return true if the next read does not block, see isPortLost()
+   */
+  bool waitForData(double dTimeout) {return m_SerialIO.waitReadable(dTimeout);}
+
+  // file descriptor of the serial port, to wait for it together with other ones
+  int getDescriptor() const {return m_SerialIO.getHandle();}
+
+  // sets the low latency mode of the serial port, applied when it is opened
+  void setLowLatency(bool bLowLatency) {m_SerialIO.setLowLatency(bLowLatency);}
+
+  // enables getTelegramWait(), so that a read usually returns the rest of a telegram
+  void setAdaptiveReads(bool bAdaptiveReads) {m_bAdaptiveReads = bAdaptiveReads;}
+
+  /**
+   * Enables the time stamps of the steps of every scan, see getScanTimes(). They are only
+   * taken if the library was built with SICKS300_LATENCY_STATS.
+   */
+  void setLatencyStats(bool bLatencyStats) {m_bLatencyStats = bLatencyStats;}
+
+  /**
+   * Returns the time stamps of the steps of the last scan returned by getScan(), lastScan()
+   * or nextScan(). The first byte is the one of the oldest of the last MAX_READ_TIMES reads
+   * holding the telegram.
+   */
+  const ScanTimes & getScanTimes() const {return m_ScanTimes;}
+
+  /**
+   * Returns the time in seconds the bytes still missing to complete the telegram being
+   * received take at the baud rate. Waiting for it before the next read saves the reads of
+   * the small chunks in between. Returns 0 if no telegram is in progress.
+   */
+  double getTelegramWait() const;
+
+  /**
+   * Reads the serial port and returns the newest scan received, older ones are skipped.
+   * With several fields set only one of them is returned, see lastScan().
+   * The measurements are decoded straight into the given arrays, which are only resized.
+   * @param vfDistanceM distances in meters
+   * @param vfIntensityAU intensities in arbitrary units
+   * @param pGeometry angles of the measurements, valid until the field is set again
+   * @param iTimestamp scan number of the scan
+   * @param iTimeNow scan number of the newest scan received, the same as iTimestamp
+   * @param bInverted whether the measurements are written in reverse order
+   */
   bool getScan(
-    std::vector<double> & vdDistanceM, std::vector<double> & vdAngleRAD,
-    std::vector<double> & vdIntensityAU, unsigned int & iTimestamp,
-    unsigned int & iTimeNow, const bool debug);
+    std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+    const ScanGeometry * & pGeometry, unsigned int & iTimestamp,
+    unsigned int & iTimeNow, const bool bInverted, const bool debug);
+
+  /**
+   * Reads the serial port once and frames the complete telegrams received,
+   * which are then returned by nextScan().
+   * @return number of bytes read, 0 or less if nothing was read
+   */
+  int receiveTelegrams();
+
+  /**
+   * Frames bytes that were not read from the serial port, e.g. replayed from a capture.
+   * The complete telegrams are then returned by nextScan(), as after receiveTelegrams().
+   */
+  void feed(const unsigned char * pData, size_t iSize);
+
+  /**
+   * Records every byte read from the serial port from now on, see CaptureWriter.
+   * @param pcPath capture file, replaced if it exists
+   * @return false if the file cannot be created
+   */
+  bool startCapture(const char * pcPath);
+
+  // closes the capture file, writing the index of its telegrams
+  void stopCapture();
+
+  /**
+   * Returns the newest scan received and drops the older ones, without reading the
+   * serial port. The outputs are the same as in getScan().
+   * With several fields set, each call returns the newest scan of the next field, so
+   * calling it until it returns false gives the newest scan of every field.
+   */
+  bool lastScan(
+    std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+    const ScanGeometry * & pGeometry, unsigned int & iScanNumber,
+    const bool bInverted, const bool debug);
+
+  /**
+   * Returns the oldest scan received and not returned yet, without reading the serial port.
+   * Calling it until it returns false drains every scan in arrival order.
+   * The outputs are the same as in getScan().
+   * @param iScanNumber scan number (time stamp) of the scan
+   */
+  bool nextScan(
+    std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+    const ScanGeometry * & pGeometry, unsigned int & iScanNumber,
+    const bool bInverted, const bool debug);
+
+  /**
+   * Returns the newest reflector telegram decoded since the previous call, nullptr if none.
+   * The reflector and I/O telegrams are decoded by getScan(), lastScan() and nextScan()
+   * while they look for the distance telegrams, including the ones that follow the scan
+   * returned. The reflectors are placed with the field of the last scan.
+   */
+  const ReflectorData * takeReflectors();
+
+  // same as takeReflectors() for the I/O telegrams
+  const IoData * takeIo();
+
+  // scan number of the newest telegram received
+  unsigned int getLastScanNumber() const {return m_uiLastReceivedScanNumber;}
+
+  /**
+   * Sets the parameters of a field and computes its geometry for the default beam count.
+   * The geometry is computed again if the scanner sends a different number of measurements.
+   */
+  void setRangeField(const int field, const ParamType & param);
+
+  // forgets every field set, so their telegrams are no longer decoded
+  void clearFields();
+
+  // geometry of a field, nullptr if the field is not set
+  const ScanGeometry * getGeometry(const int field) const;
 
-  void setRangeField(const int field, const ParamType & param) {m_Params[field] = param;}
+  // field (1 to 5) of the last scan returned, 0 before the first one
+  int getLastField() const {return m_iLastField;}
+
+  // number of complete telegrams dropped because the receive buffer was full
+  unsigned int getDroppedTelegrams() const {return m_uiDroppedTelegrams;}
+
+  // number of scan numbers missing between the scans read since the port was opened
+  unsigned int getSkippedScans() const {return m_uiSkippedScans;}
+
+  // number of candidates that matched the sync pattern but failed the CRC
+  unsigned int getCrcErrors() const {return m_Framer.getCrcErrors();}
+
+  // number of times bytes had to be skipped to find the next telegram
+  unsigned int getResyncs() const {return m_uiResyncs;}
+
+  // number of telegrams received since the port was opened
+  unsigned int getReceivedTelegrams() const {return m_uiReceivedTelegrams;}
+
+  // number of system calls made on the serial port to receive them
+  unsigned int getNumSyscalls() const {return m_SerialIO.getNumSyscalls();}
 
 private:
   // Constants
   static const double c_dPi;
 
   // Parameters
-  typedef std::map<int, ParamType> PARAM_MAP;
-  PARAM_MAP m_Params;
+  struct FieldType
+  {
+    bool bConfigured;
+    ParamType param;
+    ScanGeometry geometry;
+  };
+  FieldType m_Fields[MAX_FIELDS];       // indexed by the field code of the telegrams minus 1
+  int m_iLastField;                     // field of the last scan decoded
   double m_dBaudMult;
+  int m_iBaudRate;
+  double m_dByteTime;                   // transmission time of a byte in seconds
+  bool m_bAdaptiveReads;
+
+  // position and size of a framed telegram in the receive buffer
+  struct TelegramPos
+  {
+    size_t start;
+    size_t length;
+    unsigned int scan_number;
+    int64_t first_byte_ns, complete_ns, crc_ok_ns;
+  };
+
+  // position after the bytes of a read and time at which it returned
+  struct ReadTime
+  {
+    size_t end;
+    int64_t time_ns;
+  };
 
   // Variables
-  unsigned char m_ReadBuf[READ_BUF_SIZE + 10];
-  unsigned char m_ReadBuf2[READ_BUF_SIZE + 10];
-  unsigned int m_uiSumReadBytes;
-  std::vector<int> m_viScanRaw;
-  int m_iPosReadBuf2;
-  static unsigned char m_iScanId;
-  int m_actualBufferSize;
+  RingBuffer m_RxBuf;
+  size_t m_uiFramePos;                  // position of the framer in m_RxBuf
+  TelegramPos m_Telegrams[MAX_PENDING_TELEGRAMS];
+  int m_iFirstTelegram, m_iNumTelegrams;
+  unsigned int m_uiDroppedTelegrams;
+  unsigned int m_uiReceivedTelegrams;
+  size_t m_uiLastTelegramLength;
+  size_t m_uiLastTelegramEnd;           // position in m_RxBuf after the last telegram framed
+  unsigned int m_uiResyncs;
+  unsigned int m_uiSkippedScans;
+  unsigned int m_uiLastReceivedScanNumber, m_uiLastReadScanNumber;
+  bool m_bScanNumberValid;
+  unsigned char m_iScanId;             // device address, 7 or 8 for a slave scanner
   bool m_bInStandby;
+  bool m_bPortLost;
+
+  // Time stamps of the scans
+  bool m_bLatencyStats;
+  ReadTime m_ReadTimes[MAX_READ_TIMES];  // ring of the last reads
+  int m_iNextReadTime;
+  ScanTimes m_ScanTimes;
+
+  // Newest reflector and I/O telegrams and whether they were taken
+  ReflectorData m_Reflectors;
+  IoData m_Io;
+  bool m_bNewReflectors, m_bNewIo;
+
+  // Capture of the received bytes, null if not recording
+  std::unique_ptr<CaptureWriter> m_pCapture;
+  size_t m_uiCaptureStart;              // position in m_RxBuf of the first byte recorded
 
   // Components
   SerialIO m_SerialIO;
   TelegramParser tp_;
+  TelegramFramer m_Framer;
 
   // Functions
+  void makeRoom();
+  void frameTelegrams();
+  void addReadTime();
+  void stampTelegram(TelegramPos & telegram) const;
+  void stampScan(int iIndex);
+  enum TelegramKind
+  {
+    TELEGRAM_INVALID,                   // wrong frame or field not set
+    TELEGRAM_SCAN,
+    TELEGRAM_REFLECTORS,
+    TELEGRAM_IO
+  };
+  TelegramKind parseTelegram(
+    int iIndex, FieldType * & pField, const unsigned char * & pTelegram, const bool debug);
+  const FieldType * getField(const int field) const;
+  void decodeAuxiliary(TelegramKind kind, const unsigned char * pTelegram, const bool bInverted);
+  void popAuxiliary(unsigned int iScanNumber, const bool bInverted, const bool debug);
+  void decodeReflectors(const unsigned char * pTelegram, const bool bInverted);
+  void decodeIo(const unsigned char * pTelegram);
+  void countSkippedScans(unsigned int iScanNumber);
+  void popTelegram();
+  void clearTelegrams();
+  static void computeGeometry(const ParamType & param, size_t iNumBeams, ScanGeometry & geometry);
   void convertScanToPolar(
-    const PARAM_MAP::const_iterator param, std::vector<int> viScanRaw,
-    std::vector<ScanPolarType> & vecScanPolar);
+    FieldType & field, const unsigned char * pTelegram,
+    std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+    const ScanGeometry * & pGeometry, const bool bInverted);
 };
 
 #endif  // SICKS300_ROS2__COMMON__SCANNERSICKS300_HPP_
@@ -0,0 +1,157 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__SERIALCAPTURE_HPP_
+#define SICKS300_ROS2__COMMON__SERIALCAPTURE_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <functional>
+#include <vector>
+
+/**
+ * Recording of the bytes received from the serial port.
+ *
+ * The file is written append only, in the byte order of the host (little endian):
+ *
+ *      | header |        magic "S300CAP1", version, baud rate, start time
+ *      | chunk |         receive time in ns, size, type, then the bytes of one read
+ *        ...             padded to 8 bytes, so every record is aligned in a mapping
+ *      | index |         stream offset, size and scan number of every telegram framed
+ *      | footer |        magic "S300IDX1", file offset and size of the index
+ *
+ * The index and the footer are written when the capture is closed. The chunks of a
+ * capture that was not closed (e.g. a crash) can still be replayed, only the index is
+ * missing. Stream offsets count the received bytes from the start of the capture.
+ */
+class CaptureWriter
+{
+public:
+  CaptureWriter();
+  ~CaptureWriter();
+
+  CaptureWriter(const CaptureWriter &) = delete;
+  CaptureWriter & operator=(const CaptureWriter &) = delete;
+
+  /**
+   * Creates the file, replacing an existing one.
+   * @param baud_rate baud rate of the port, stored for the replay
+   */
+  bool open(const char * path, int baud_rate);
+
+  /// Writes the index and the footer and closes the file.
+  void close();
+
+  bool isOpen() const {return file_ != nullptr;}
+
+  /**
+   * Appends the bytes of one read, which may come in two parts.
+   * @param receive_ns host time in nanoseconds at which they were read
+   */
+  void writeChunk(
+    int64_t receive_ns, const unsigned char * data, size_t size,
+    const unsigned char * wrapped = nullptr, size_t wrapped_size = 0);
+
+  /**
+   * Adds a telegram to the index.
+   * @param stream_offset offset of its first byte in the received bytes
+   */
+  void addTelegram(uint64_t stream_offset, uint32_t length, uint32_t scan_number);
+
+  /// Number of bytes recorded since the capture was opened.
+  uint64_t getStreamSize() const {return stream_size_;}
+
+private:
+  struct IndexEntry
+  {
+    uint64_t stream_offset;
+    uint32_t length;
+    uint32_t scan_number;
+  };
+
+  FILE * file_;
+  uint64_t file_size_, stream_size_;
+  std::vector<IndexEntry> index_;
+};
+
+/**
+ * Memory mapped capture, to replay it through the parser.
+ */
+class CaptureReader
+{
+public:
+  struct Chunk
+  {
+    const unsigned char * data;    // bytes of the read, inside the mapping
+    size_t size;
+    int64_t receive_ns;
+    uint64_t stream_offset;        // offset of the first byte in the received bytes
+  };
+
+  struct Telegram
+  {
+    uint64_t stream_offset;
+    uint32_t length;
+    uint32_t scan_number;
+  };
+
+  // Called for every chunk replayed, returning false stops the replay
+  typedef std::function<bool (const Chunk & chunk)> ChunkCallback;
+
+  CaptureReader();
+  ~CaptureReader();
+
+  CaptureReader(const CaptureReader &) = delete;
+  CaptureReader & operator=(const CaptureReader &) = delete;
+
+  bool open(const char * path);
+  void close();
+
+  int getBaudRate() const {return baud_rate_;}
+
+  /// Host time in nanoseconds at which the capture was started.
+  int64_t getStartTime() const {return start_ns_;}
+
+  const std::vector<Chunk> & getChunks() const {return chunks_;}
+
+  /// Whether the index was written, i.e. the capture was closed properly.
+  bool hasIndex() const {return telegrams_ != nullptr;}
+
+  const Telegram * getTelegrams() const {return telegrams_;}
+  size_t getNumTelegrams() const {return num_telegrams_;}
+
+  /// Index of the chunk holding the byte at stream_offset, to start a replay at a telegram.
+  size_t findChunk(uint64_t stream_offset) const;
+
+  /**
+   * Hands the chunks to the callback keeping the time between them, divided by speed.
+   * @param speed 1 for real time, 0 or less to replay as fast as possible
+   * @param first_chunk index of the first chunk replayed
+   * @return number of chunks replayed
+   */
+  size_t replay(double speed, const ChunkCallback & on_chunk, size_t first_chunk = 0) const;
+
+private:
+  void * mapping_;
+  size_t mapping_size_;
+  int baud_rate_;
+  int64_t start_ns_;
+  std::vector<Chunk> chunks_;
+  const Telegram * telegrams_;
+  size_t num_telegrams_;
+};
+
+#endif  // SICKS300_ROS2__COMMON__SERIALCAPTURE_HPP_
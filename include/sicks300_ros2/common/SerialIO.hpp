@@ -19,6 +19,7 @@
 
 #include <termios.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <string.h>
 
 #include <string>
@@ -107,6 +108,13 @@ public:
    */
   void setTimeout(double Timeout);
 
+  /**
+   * Sets the ASYNC_LOW_LATENCY flag when the port is opened, so USB adapters deliver
+   * the received bytes without waiting for their latency timer.
+   * @param LowLatency default is false.
+   */
+  void setLowLatency(bool LowLatency) {m_LowLatency = LowLatency;}
+
   /**
    * Sets the byte period for transmitting bytes.
    * If the period is not equal to 0, the transmit will be repeated with the given
@@ -144,6 +152,26 @@ public:
    */
   int readNonBlocking(char * Buffer, int Length);
 
+  /**
+   * Reads the serial port into several buffers with a single call.
+   * Returns as soon as some bytes are available, like readBlocking().
+   * @param Buffers buffers filled in order
+   * @param Count number of buffers
+   */
+  int readVector(const ::iovec * Buffers, int Count);
+
+  /**
+   * Waits until the serial port has data to read, or was hung up.
+   * @param Timeout maximum waiting time in seconds
+   * @return true if a read does not block, false on timeout
+   */
+  bool waitReadable(double Timeout);
+
+  /**
+   * Returns the file descriptor of the serial port, -1 if it is closed.
+   */
+  int getHandle() const {return m_Device;}
+
   /**
    * Writes bytes to the serial port.
    * @param Buffer buffer of the message
@@ -156,6 +184,12 @@ public:
    */
   int getSizeRXQueue();
 
+  /**
+   * Returns the number of system calls made to receive data (waits, queue size
+   * queries and reads) since the port was opened.
+   */
+  unsigned int getNumSyscalls() const {return m_NumSyscalls;}
+
 
   /** Clears the read and transmit buffer.
    */
@@ -190,6 +224,9 @@ public:
   }
 
 protected:
+  // Writes m_tio to the device, followed by the custom baudrate if there is one
+  int setAttributes();
+
   ::termios m_tio;
   std::string m_DeviceName;
   int m_Device;
@@ -202,6 +239,9 @@ protected:
   double m_Timeout;
   ::timeval m_BytePeriod;
   bool m_ShortBytePeriod;
+  bool m_LowLatency;
+  int m_CustomBaudRate;             // baudrate without termios code, 0 if there is a code
+  unsigned int m_NumSyscalls;
 };
 
 
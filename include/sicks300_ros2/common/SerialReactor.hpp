@@ -0,0 +1,164 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__SERIALREACTOR_HPP_
+#define SICKS300_ROS2__COMMON__SERIALREACTOR_HPP_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sicks300_ros2/common/ScannerSickS300.hpp"
+
+/**
+ * Services the serial ports of many scanners from a single thread.
+ *
+ * The descriptors of the registered scanners are waited for with one epoll instance.
+ * When a port is readable its bytes are read into the receive buffer of the scanner,
+ * framed, decoded and handed to the callback of the scanner, all in the reactor
+ * thread. Adding scanners does not add threads.
+ *
+ * While a telegram is being received its port is left out of the wait for the time the
+ * missing bytes take (see ScannerSickS300::getTelegramWait()), so that the next read
+ * returns the rest of the telegram instead of the small chunks in between.
+ *
+ * The callbacks must not add or remove scanners.
+ */
+class SerialReactor
+{
+public:
+  // Scan delivered to the callbacks
+  struct Scan
+  {
+    // The callback may swap these arrays with its own ones, so no copy is needed
+    std::vector<float> ranges;          // distances in meters
+    std::vector<float> intensities;     // intensities in arbitrary units
+    const ScannerSickS300::ScanGeometry * geometry;
+    unsigned int scan_number;           // scan number of the scan
+    unsigned int newest_scan_number;    // scan number of the newest telegram received
+    bool in_standby;
+  };
+
+  typedef std::function<void (Scan & scan)> ScanCallback;
+  typedef std::function<void ()> TimeoutCallback;
+
+  struct Options
+  {
+    bool inverted = false;              // write the measurements in reverse order
+    bool all_scans = false;             // deliver every scan, not only the newest per field
+    double timeout = 0.0;               // seconds without scans before on_timeout
+    bool debug = false;
+  };
+
+  // Settings of the reactor thread, shared by every scanner registered
+  struct ThreadSettings
+  {
+    int priority = 0;                   // SCHED_FIFO priority, 0 for the default policy
+    std::vector<int> cpus;              // CPUs the thread runs on, empty for any
+
+    bool operator==(const ThreadSettings & other) const
+    {
+      return priority == other.priority && cpus == other.cpus;
+    }
+  };
+
+  SerialReactor();
+  ~SerialReactor();
+
+  SerialReactor(const SerialReactor &) = delete;
+  SerialReactor & operator=(const SerialReactor &) = delete;
+
+  /**
+   * Returns the reactor shared by every user of the process, created on the first call
+   * and destroyed when the last user releases it.
+   */
+  static std::shared_ptr<SerialReactor> getShared();
+
+  /**
+   * Registers an open scanner. It must not be used by other threads until removed.
+   * @param on_scan called for every scan delivered
+   * @param on_timeout called when no scan was received for options.timeout seconds
+   * @return false if the port cannot be waited for
+   */
+  bool add(
+    ScannerSickS300 & scanner, const Options & options, ScanCallback on_scan,
+    TimeoutCallback on_timeout = TimeoutCallback());
+
+  /**
+   * Unregisters a scanner. When it returns its callbacks are no longer running.
+   */
+  void remove(ScannerSickS300 & scanner);
+
+  /// Starts the reactor thread, which runs until stop() is called.
+  void start();
+
+  /// Stops the reactor thread and waits for it to finish.
+  void stop();
+
+  /**
+   * Applies the settings of the first caller to the reactor thread while it is running.
+   * The thread is shared, so the later callers must ask for the same settings, which are
+   * then left as they are.
+   * @param priority_error result of RealTime::setPriority(), 0 if no priority was set
+   * @param affinity_error result of RealTime::setAffinity(), 0 if no CPU was set
+   * @return false if different settings were already applied
+   */
+  bool applyThreadSettings(
+    const ThreadSettings & settings, int & priority_error, int & affinity_error);
+
+  /**
+   * Waits for the registered ports and services the readable ones once.
+   * @param timeout maximum waiting time in seconds
+   * @return number of ports serviced, -1 on error
+   */
+  int runOnce(double timeout);
+
+private:
+  struct Registration
+  {
+    ScannerSickS300 * scanner;
+    Options options;
+    ScanCallback on_scan;
+    TimeoutCallback on_timeout;
+    Scan scan;
+    int64_t last_scan_ns;
+    int64_t resume_ns;                  // time to wait for the port again, 0 if waited for
+    bool active;                        // the port is still being waited for
+  };
+
+  void service(Registration & registration);
+  void checkTimeouts();
+  void resumePorts(int64_t now);
+  int64_t getNextResume() const;
+  void wakeUp();
+
+  int epoll_fd_, wake_fd_;
+  std::mutex mutex_;
+  std::list<Registration> registrations_;
+  std::thread thread_;
+  std::atomic<bool> running_;
+
+  // Settings applied to the thread by the first caller, guarded by mutex_
+  bool thread_settings_applied_;
+  ThreadSettings thread_settings_;
+  int priority_error_, affinity_error_;
+};
+
+#endif  // SICKS300_ROS2__COMMON__SERIALREACTOR_HPP_
@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__TELEGRAMFRAMER_HPP_
+#define SICKS300_ROS2__COMMON__TELEGRAMFRAMER_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Incremental framer for the S300 continuous data output.
+ *
+ * The framer walks forward over the received bytes looking for the sync pattern
+ * "00 00 00 00 00 00 xx xx FF xx" (reply header, block number, size, coordination flag
+ * and device address). Its position and the partial CRC of the current candidate are kept
+ * between calls, so a telegram split over several reads is never searched twice and every
+ * byte of a candidate goes through the CRC only once. For protocol 0x0301 the two possible
+ * size rules are checked on the way, as the shorter telegram is a prefix of the longer one.
+ * The rule of the first telegram found is then the only one checked, until several
+ * candidates in a row fail with it. When a device address is set, the candidates sent by
+ * any other device are skipped like a false sync.
+ *
+ * All offsets are relative to the first byte still held by the caller, who must call
+ * consume() whenever bytes are removed from the front of its buffer.
+ */
+class TelegramFramer
+{
+public:
+  enum
+  {
+    MIN_TELEGRAM_SIZE = 24,      // common header, output type and CRC
+    MAX_TELEGRAM_SIZE = 2048,    // 541 measurements take 1108 bytes
+    MAX_SIZE_RULE_FAILURES = 3,  // failed candidates before both size rules are checked again
+    ANY_ADDRESS = -1             // the telegrams of every device are framed
+  };
+
+  TelegramFramer();
+
+  /**
+   * Forgets the current candidate and starts searching the sync pattern again.
+   * The size rule found for protocol 0x0301 is kept.
+   */
+  void reset();
+
+  /**
+   * Sets the device address the telegrams must carry in their 10th byte.
+   * @param address 7, or 8 for a slave scanner; ANY_ADDRESS to frame every telegram
+   */
+  void setDeviceAddress(int address) {device_address_ = address;}
+
+  /**
+   * Searches forward for the next complete telegram with a valid CRC.
+   * @param buffer received bytes not consumed yet
+   * @param size number of bytes in buffer
+   * @param start offset of the telegram found in buffer
+   * @param length size of the telegram found in bytes
+   * @return true if a telegram was found, false if more data is needed
+   */
+  bool next(const unsigned char * buffer, size_t size, size_t & start, size_t & length);
+
+  /**
+   * Informs the framer that the first count bytes were removed from the buffer.
+   * @param count number of bytes removed, at most discardable()
+   */
+  void consume(size_t count);
+
+  /**
+   * Returns the number of leading bytes that can no longer be part of a telegram.
+   */
+  size_t discardable() const;
+
+  /**
+   * Returns the number of bytes still missing to complete the current candidate,
+   * 0 if its size is not known yet.
+   * @param size number of bytes in the buffer
+   */
+  size_t missing(size_t size) const;
+
+  /**
+   * Returns the number of candidates that matched the sync pattern but failed the CRC.
+   */
+  unsigned int getCrcErrors() const {return crc_errors_;}
+
+private:
+  enum State {SYNC, HEADER, CRC};
+
+  bool findSync(const unsigned char * buffer, size_t size);
+  bool readHeader(const unsigned char * buffer, size_t size);
+  bool checkCrc(const unsigned char * buffer, size_t size, size_t & length);
+
+  State state_;
+  size_t pos_;                   // next byte to be examined by the sync search
+  size_t zero_run_;              // consecutive zero bytes before pos_
+  size_t start_;                 // start of the current candidate
+  size_t crc_pos_;               // next byte of the candidate to go through the CRC
+  uint16_t crc_;                 // CRC of the candidate up to crc_pos_
+  size_t lengths_[2];            // possible lengths of the candidate
+  int num_lengths_, length_idx_;
+  bool new_protocol_;            // the candidate is sized with the rules of protocol 0x0301
+  int size_rule_;                // index in lengths_ of the rule found for 0x0301, -1 if none
+  int size_rule_failures_;       // candidates failed in a row with that rule
+  unsigned int crc_errors_;
+  int device_address_;           // address of the telegrams framed, or ANY_ADDRESS
+};
+
+#endif  // SICKS300_ROS2__COMMON__TELEGRAMFRAMER_HPP_
@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__TELEGRAMGENERATOR_HPP_
+#define SICKS300_ROS2__COMMON__TELEGRAMGENERATOR_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+/**
+ * Builds the telegrams of the S300 continuous data output, as sent by a scanner.
+ *
+ * Every call to next() returns the distance telegram of the following scan, with its scan
+ * number, telegram number and CRC. The distances describe a room whose walls move slowly
+ * from one scan to the next, with a reflector every 50 measurements. In standby every
+ * measurement is 0x4004, like the scanner does. The reflector and I/O telegrams of that
+ * scan are then returned by nextReflectors() and nextIo().
+ *
+ * It is used to emulate a scanner on a pseudo-terminal and to feed the benchmarks.
+ */
+class TelegramGenerator
+{
+public:
+  // Rule used to compute the size field, see TelegramFramer::readHeader
+  enum Protocol
+  {
+    PROTOCOL_0102,               // old protocol, size from the 5th byte including the CRC
+    PROTOCOL_0301,               // size from the 9th byte including the CRC
+    PROTOCOL_0301_FIELDS         // I/O or fields configured, from the 13th byte to the CRC
+  };
+
+  struct Options
+  {
+    Protocol protocol = PROTOCOL_0301;
+    unsigned char device_address = 7;
+    int field = 1;               // measurement field, 1 to 5
+    size_t num_beams = 541;
+    unsigned int first_scan_number = 0;
+  };
+
+  explicit TelegramGenerator(const Options & options);
+
+  /**
+   * Builds the telegram of the next scan.
+   * @return bytes of the telegram, valid until the next call
+   */
+  const std::vector<unsigned char> & next();
+
+  /**
+   * Builds the reflector telegram of the scan returned by the last call to next(), with one
+   * reflector per measurement that has its reflector bit set.
+   * @return bytes of the telegram, valid until the next call
+   */
+  const std::vector<unsigned char> & nextReflectors();
+
+  /**
+   * Builds a reflector telegram of the scan returned by the last call to next() with the
+   * given words, e.g. to send beams out of the scan.
+   * @param words first beam, last beam and distance of every reflector
+   * @return bytes of the telegram, valid until the next call
+   */
+  const std::vector<unsigned char> & nextReflectors(const std::vector<uint16_t> & words);
+
+  /**
+   * Builds the I/O telegram of the scan returned by the last call to next().
+   * @param words state of the inputs and outputs, sent after the type
+   * @return bytes of the telegram, valid until the next call
+   */
+  const std::vector<unsigned char> & nextIo(const std::vector<uint16_t> & words);
+
+  /// Whether the following telegrams report the scanner in standby.
+  void setStandby(bool standby) {standby_ = standby;}
+
+  /// Scan number of the next telegram.
+  unsigned int getScanNumber() const {return scan_number_;}
+
+  /// Size in bytes of every telegram.
+  size_t getTelegramSize() const {return telegram_.size();}
+
+  /**
+   * Parses a protocol name: "0102", "0301" or "0301-fields".
+   * @return false if the name is unknown
+   */
+  static bool parseProtocol(const char * name, Protocol & protocol);
+
+private:
+  enum
+  {
+    HEADER_SIZE = 24,            // common header, output type and field
+    TYPE_END = 22,               // the reflector and I/O telegrams have no field
+    CRC_SIZE = 2,
+    STANDBY_VALUE = 0x4004,
+    REFLECTOR_BIT = 0x2000,
+    REFLECTOR_SPACING = 50
+  };
+
+  // Writes the header of a telegram, whose size is already set, with the given output type
+  void putHeader(std::vector<unsigned char> & telegram, unsigned int type) const;
+  // Writes the scan and telegram numbers and the CRC of a telegram
+  void finish(std::vector<unsigned char> & telegram, unsigned int scan_number);
+  // Builds a telegram of the last scan holding the given words after its output type
+  const std::vector<unsigned char> & nextWords(
+    const std::vector<uint16_t> & words, unsigned int type);
+
+  Options options_;
+  std::vector<unsigned char> telegram_, auxiliary_;
+  unsigned int scan_number_;
+  uint16_t telegram_number_;
+  bool standby_;
+};
+
+#endif  // SICKS300_ROS2__COMMON__TELEGRAMGENERATOR_HPP_
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <arpa/inet.h>
+#include <string.h>
 #include <iostream>
 #include <vector>
 
@@ -196,161 +197,43 @@ class TelegramParser
   //-------------------------------------------
   static unsigned int createCRC(uint8_t * ptrData, int Size);
 
-  // Supports versions: 0301, 0201
-  static bool check(const TELEGRAM_COMMON1 & tc, const uint8_t DEVICE_ADDR)
-  {
-    uint8_t TELEGRAM_COMMON_PATTERN_EQ[] =
-    {0, 0, 0, 0, 0, 0, 0, 0, 0xFF, static_cast<uint8_t>(0 & DEVICE_ADDR) /*version, 2, 1*/};
-    uint8_t TELEGRAM_COMMON_PATTERN_OR[] =
-    {0, 0, 0, 0, 0, 0, 0xff, 0xff, 0, 0xff /*version, 1, 0*/};
-
-    for (size_t i = 0; i < sizeof(TELEGRAM_COMMON_PATTERN_EQ); i++) {
-      if (TELEGRAM_COMMON_PATTERN_EQ[i] != (tc.bytes[i] & (~TELEGRAM_COMMON_PATTERN_OR[i])) ) {
-        // std::cout<<"invalid at byte "<<i<<std::endl;
-        return false;
-      }
-    }
-
-    return true;
-  }
+public:
+  // Continues the CRC-16/CCITT crc over Size bytes, 0xFFFF starts a new one
+  static uint16_t updateCRC(uint16_t crc, const uint8_t * ptrData, size_t Size);
 
+private:
   TELEGRAM_COMMON1 tc1_;
   TELEGRAM_COMMON2 tc2_;
   TELEGRAM_COMMON3 tc3_;
   TELEGRAM_DISTANCE td_;
-  int size_field_start_byte_, crc_bytes_in_size_, user_data_size_;
+  int user_data_size_;
 
 public:
   TelegramParser()
-  : size_field_start_byte_(0),
-    crc_bytes_in_size_(0),
-    user_data_size_(0)
+  : user_data_size_(0)
   {
   }
 
-  bool parseHeader(
-    const unsigned char * buffer, const size_t max_size, const uint8_t DEVICE_ADDR,
-    const bool debug)
+  // Decodes a complete telegram whose size and CRC were already checked by the framer
+  bool parseFrame(const unsigned char * buffer, const size_t size, const bool debug)
   {
-    if (sizeof(tc1_) > max_size) {return false;}
-    tc1_ = *reinterpret_cast<const TELEGRAM_COMMON1 *>(buffer);
-
-    if (!check(tc1_, DEVICE_ADDR)) {
-      // if(debug) std::cout<<"basic check failed"<<std::endl;
+    if (size < sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + sizeof(TELEGRAM_COMMON3) +
+      sizeof(TELEGRAM_TAIL))
+    {
       return false;
     }
 
+    tc1_ = *reinterpret_cast<const TELEGRAM_COMMON1 *>(buffer);
     ntoh(tc1_);
     if (debug) {print(tc1_);}
-
     tc2_ = *(reinterpret_cast<const TELEGRAM_COMMON2 *>(buffer + sizeof(TELEGRAM_COMMON1)));
+    ntoh(tc2_);
     tc3_ =
       *(reinterpret_cast<const TELEGRAM_COMMON3 *>(buffer +
       (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2))));
-
-    TELEGRAM_TAIL tt;
-    uint16_t crc;
-    int full_data_size = 0;
-
-    // The size reported by the protocol varies depending on the calculation
-    // which is different depending on several factors.
-    // The calculation is described on pp. 70-73 in:
-    // https://www.sick.com/media/dox/1/91/891/Telegram_listing_S3000_Expert_Anti_Collision_S300_Expert_de_en_IM0022891.PDF // NOLINT
-    //
-    // Also, the size is reported as 16bit-words = 2 bytes...
-    //
-    // For the old protocol/compatability mode:
-    // "The telegram size is calculated starting with the 5 byte up to and including the CRC."
-    if (tc2_.common2.protocol_version == 0x102) {
-      size_field_start_byte_ = 4;               // start at 5th byte (started numbering at 0)
-      crc_bytes_in_size_ = 2;                   // include 2 bytes CRC
-
-      // the user_data_size is the size of the actual payload data in bytes,
-      // i.e. all data except of the CRC and the first two common telegrams
-      user_data_size_ =
-        2 * tc1_.common1.size -
-        (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) - size_field_start_byte_ +
-        crc_bytes_in_size_);
-      full_data_size = sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_ +
-        sizeof(TELEGRAM_TAIL);
-
-      tt =
-        *(reinterpret_cast<const TELEGRAM_TAIL *>(buffer +
-        (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_)) );
-      ntoh(tt);
-      crc =
-        createCRC(
-        const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(buffer)) + JUNK_SIZE,
-        full_data_size - JUNK_SIZE - sizeof(TELEGRAM_TAIL));
-    } else {
-      // Special handling for the new protocol, as the settings cannot be fully deduced
-      // from the protocol itself
-      // Thus, we have to try both possibilities and check against the CRC...
-      // If NO I/O or measuring fields are configured:
-      // "The telegram size is calculated starting with the 9 byte up to and including the CRC."
-      size_field_start_byte_ = 8;               // start at 9th byte (started numbering at 0)
-      crc_bytes_in_size_ = 2;                   // include 2 bytes CRC
-      user_data_size_ =
-        2 * tc1_.common1.size -
-        (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) - size_field_start_byte_ +
-        crc_bytes_in_size_);
-      full_data_size = sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_ +
-        sizeof(TELEGRAM_TAIL);
-
-      tt =
-        *(reinterpret_cast<const TELEGRAM_TAIL *>(buffer +
-        (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_)) );
-      ntoh(tt);
-      crc =
-        createCRC(
-        const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(buffer)) + JUNK_SIZE,
-        full_data_size - JUNK_SIZE - sizeof(TELEGRAM_TAIL));
-
-      if (tt.crc_struct.crc != crc) {
-        // If any I/O or measuring field is configured:
-        // "The telegram size is calculated starting with the 13 byte up to and including the
-        // last byte bevfre (sic!) the CRC."
-        size_field_start_byte_ = 12;                // start at 13th byte (started numbering at 0)
-        crc_bytes_in_size_ = 0;                     // do NOT include 2 bytes CRC
-        user_data_size_ =
-          2 * tc1_.common1.size -
-          (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) - size_field_start_byte_ +
-          crc_bytes_in_size_);
-        full_data_size =
-          sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_ +
-          sizeof(TELEGRAM_TAIL);
-
-        tt =
-          *(reinterpret_cast<const TELEGRAM_TAIL *>(buffer +
-          (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_)) );
-        ntoh(tt);
-        crc =
-          createCRC(
-          const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(buffer)) + JUNK_SIZE,
-          full_data_size - JUNK_SIZE - sizeof(TELEGRAM_TAIL));
-      }
-    }
-
-    if ( (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_ +
-      sizeof(TELEGRAM_TAIL)) > static_cast<size_t>(max_size))
-    {
-      if (debug) {std::cout << "invalid header size" << std::endl;}
-      return false;
-    }
-
-
-    if (tt.crc_struct.crc != crc) {
-      if (debug) {
-        print(tc2_);
-        print(tc3_);
-        print(tt);
-        std::cout << "at " << std::dec <<
-          (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) + user_data_size_) << std::hex <<
-          std::endl;
-        std::cout << "invalid CRC: " << crc << " (" << tt.crc_struct.crc << ")" << std::endl;
-      }
-      return false;
-    }
+    ntoh(tc3_);
+    user_data_size_ = size - (sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) +
+      sizeof(TELEGRAM_TAIL));
 
     memset(&td_, 0, sizeof(td_));
     switch (tc3_.type.type) {
@@ -358,12 +241,16 @@ public:
 
       case DISTANCE:
         if (debug) {std::cout << "got distance" << std::endl;}
+        if (user_data_size_ < static_cast<int>(sizeof(TELEGRAM_COMMON3) +
+          sizeof(TELEGRAM_DISTANCE)))
+        {
+          return false;
+        }
 
         td_ =
           *(reinterpret_cast<const TELEGRAM_DISTANCE *>(buffer + sizeof(TELEGRAM_COMMON1) +
           sizeof(TELEGRAM_COMMON2) + sizeof(TELEGRAM_COMMON3)));
         ntoh(td_);
-        // print(td_);
         break;
 
       case REFLEXION: break;
@@ -374,6 +261,8 @@ public:
   }
 
   bool isDist() const {return tc3_.type.type == DISTANCE;}
+  bool isReflectors() const {return tc3_.type.type == REFLEXION;}
+  bool isIo() const {return tc3_.type.type == IO;}
   int getField() const
   {
     switch (td_.type.type) {
@@ -392,14 +281,47 @@ public:
            sizeof(TELEGRAM_TAIL);
   }
 
+  uint32_t getScanNumber() const {return tc2_.common2.scan_number;}
+
+  size_t getNumPoints() const
+  {
+    if (!isDist()) {return 0;}
+    return (user_data_size_ - sizeof(TELEGRAM_COMMON3) - sizeof(TELEGRAM_DISTANCE)) /
+           sizeof(TELEGRAM_S300_DIST_2B);
+  }
+
+  // Number of 16 bit words after the type of a reflector or I/O telegram
+  size_t getNumWords() const
+  {
+    if (isDist() || user_data_size_ < static_cast<int>(sizeof(TELEGRAM_COMMON3))) {return 0;}
+    return (user_data_size_ - sizeof(TELEGRAM_COMMON3)) / 2;
+  }
+
+  // A reflector telegram holds REFLECTOR_WORDS words per reflector: index of its first
+  // measurement, index of its last measurement and distance in cm
+  enum TELEGRAM_REFLECTOR {REFLECTOR_WORDS = 3};
+
+  // First word after the type of a reflector or I/O telegram, each one takes 2 bytes in
+  // little endian like the measurements
+  static const unsigned char * getWordData(const unsigned char * buffer)
+  {
+    return buffer + sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) +
+           sizeof(TELEGRAM_COMMON3);
+  }
+
+  // First measurement of a distance telegram, each one takes 2 bytes in little endian
+  static const unsigned char * getDistData(const unsigned char * buffer)
+  {
+    return buffer + sizeof(TELEGRAM_COMMON1) + sizeof(TELEGRAM_COMMON2) +
+           sizeof(TELEGRAM_COMMON3) + sizeof(TELEGRAM_DISTANCE);
+  }
+
   void readDistRaw(const unsigned char * buffer, std::vector<int> & res, bool debug) const
   {
     res.clear();
     if (!isDist()) {return;}
 
-    size_t num_points =
-      (user_data_size_ - sizeof(TELEGRAM_COMMON3) - sizeof(TELEGRAM_DISTANCE)) /
-      sizeof(TELEGRAM_S300_DIST_2B);
+    size_t num_points = getNumPoints();
     if (debug) {std::cout << "Number of points: " << std::dec << num_points << std::endl;}
     for (size_t i = 0; i < num_points; ++i) {
       TELEGRAM_S300_DIST_2B dist =
@@ -0,0 +1,143 @@
+// Copyright (c) 2022 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__SCAN_FILTER_HPP_
+#define SICKS300_ROS2__SCAN_FILTER_HPP_
+
+// C++
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ROS
+#include "rclcpp/rclcpp.hpp"
+#include "sensor_msgs/msg/laser_scan.hpp"
+
+namespace sicks300_ros2
+{
+
+/**
+ * @class sicks300_ros2::ScanFilter
+ * @brief Angular bounds filter for the laser scans
+ */
+class ScanFilter : public rclcpp::Node
+{
+public:
+  /**
+   * @brief Construct a new Scan Filter object
+   * @param options Node options
+   */
+  explicit ScanFilter(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+
+  /**
+   * @brief Crop a scan in place to count beams from first
+   *
+   * The intensities are cropped as the ranges, or cleared if they do not cover every beam
+   * kept, so the arrays published always have the same size.
+   *
+   * @param msg Laser scan to crop
+   * @param first Index of the first beam kept
+   * @param count Number of beams kept, first + count is at most the size of the ranges
+   */
+  static void crop_scan(sensor_msgs::msg::LaserScan & msg, size_t first, size_t count);
+
+  /**
+   * @brief Compute the beams inside the angular bounds
+   *
+   * The first beam at or after the lower bound is kept, then every beam up to the upper
+   * bound, but at least one. No beam is kept if the lower bound is after the last beam.
+   *
+   * @param lower_angle Lower bound
+   * @param upper_angle Upper bound
+   * @param angle_min Angle of the first beam of the scan
+   * @param angle_increment Angle between two beams, every beam is kept if not positive
+   * @param size Number of beams of the scan
+   * @param first Index of the first beam kept, size if none
+   * @param count Number of beams kept
+   */
+  static void compute_window(
+    double lower_angle, double upper_angle, float angle_min, float angle_increment,
+    size_t size, size_t & first, size_t & count);
+
+private:
+  /**
+   * @brief Declares static ROS2 parameter and sets it to a given value if it was not already declared.
+   *
+   * @param node A node in which given parameter to be declared
+   * @param param_name The name of parameter
+   * @param default_value Parameter value to initialize with
+   * @param parameter_descriptor Parameter descriptor (optional)
+  */
+  template<typename NodeT>
+  void declare_parameter_if_not_declared(
+    NodeT node,
+    const std::string & param_name,
+    const rclcpp::ParameterValue & default_value,
+    const rcl_interfaces::msg::ParameterDescriptor & parameter_descriptor =
+    rcl_interfaces::msg::ParameterDescriptor())
+  {
+    if (!node->has_parameter(param_name)) {
+      node->declare_parameter(param_name, default_value, parameter_descriptor);
+    }
+  }
+
+  /**
+   * @brief Update the angular bounds at runtime
+   *
+   * @param parameters Parameters to set
+   * @return Result of the update
+   */
+  rcl_interfaces::msg::SetParametersResult parameters_callback(
+    const std::vector<rclcpp::Parameter> & parameters);
+
+  /**
+   * @brief Compute the beams inside the angular bounds for the geometry of the scan
+   *
+   * @param msg Laser scan whose geometry is used
+   */
+  void update_window(const sensor_msgs::msg::LaserScan & msg);
+
+  /**
+   * @brief Crop the scan to the angular bounds and publish it
+   *
+   * The message is owned by the callback, so it is cropped in place and the same
+   * buffers are published. Within a component container with intra-process
+   * communication the scan of the driver is neither copied nor serialized.
+   *
+   * @param msg Laser scan to filter
+   */
+  void scan_callback(sensor_msgs::msg::LaserScan::UniquePtr msg);
+
+  rclcpp::Subscription<sensor_msgs::msg::LaserScan>::SharedPtr laser_scan_sub_;
+  rclcpp::Publisher<sensor_msgs::msg::LaserScan>::SharedPtr laser_scan_filtered_pub_;
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr parameters_handle_;
+
+  // Beams kept for the last geometry seen, computed again when the geometry or the
+  // bounds change
+  struct IndexWindow
+  {
+    bool valid;
+    float angle_min, angle_increment;
+    size_t size;
+    size_t first, count;
+  };
+
+  std::mutex mutex_;
+  float lower_angle_, upper_angle_;
+  IndexWindow window_;
+};
+
+}  // namespace sicks300_ros2
+
+#endif  // SICKS300_ROS2__SCAN_FILTER_HPP_
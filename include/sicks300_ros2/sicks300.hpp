@@ -16,8 +16,12 @@
 #define SICKS300_ROS2__SICKS300_HPP_
 
 // C++
-#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 // ROS
 #include "rclcpp/rclcpp.hpp"
@@ -25,11 +29,18 @@
 #include "rclcpp_lifecycle/lifecycle_publisher.hpp"
 #include "lifecycle_msgs/msg/transition.hpp"
 #include "std_msgs/msg/bool.hpp"
+#include "std_msgs/msg/u_int16_multi_array.hpp"
+#include "geometry_msgs/msg/pose_array.hpp"
 #include "sensor_msgs/msg/laser_scan.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
 #include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "diagnostic_msgs/msg/diagnostic_status.hpp"
 
 // Common
+#include "sicks300_ros2/common/LatencyHistogram.hpp"
+#include "sicks300_ros2/common/ScanClock.hpp"
 #include "sicks300_ros2/common/ScannerSickS300.hpp"
+#include "sicks300_ros2/common/SerialReactor.hpp"
 
 namespace sicks300_ros2
 {
@@ -95,6 +106,23 @@ public:
   CallbackReturn on_shutdown(const rclcpp_lifecycle::State & state) override;
 
 protected:
+  // Counters of the scans, updated by the reader after every scan and published as
+  // differences over every diagnostics_period
+  struct DiagnosticTotals
+  {
+    unsigned int scans;              // scans received, in standby or not
+    unsigned int standby_scans;      // scans received in standby
+    unsigned int skipped_scans;
+    unsigned int dropped_telegrams;
+    unsigned int crc_errors;
+    unsigned int resyncs;
+    unsigned int telegrams;
+    unsigned int syscalls;
+    unsigned int clock_rejected;
+    double clock_jitter;
+    bool in_standby;
+  };
+
   /**
    * @brief Declares static ROS2 parameter and sets it to a given value if it was not already declared.
    *
@@ -131,51 +159,202 @@ protected:
   bool receiveScan();
 
   /**
-   * @brief Publish the standby status
+   * @brief Publish the scan decoded into laser_scan_, or the standby status if the scanner
+   * is in standby
+   *
+   * @param geometry Angles of the measurements
+   * @param iSickTimeStamp Scan number of the scan
+   */
+  void handleScan(
+    const ScannerSickS300::ScanGeometry & geometry, unsigned int iSickTimeStamp);
+
+  /**
+   * @brief Start reading the serial port from the dedicated thread or from the reactor
+   * shared by the scanners of the process, depending on the acquisition mode
+   */
+  void startReader();
+
+  /**
+   * @brief Stop the serial reader thread, or leave the reactor, and wait for it to finish
+   */
+  void stopReader();
+
+  /**
+   * @brief Log and keep for the diagnostics whether the real-time priority and the CPU
+   * affinity of the parameters were applied to the thread reading the scanner
+   *
+   * @param priority_error Result of setting the priority, 0 if applied or not set
+   * @param affinity_error Result of setting the affinity, 0 if applied or not set
+   */
+  void reportThreadSettings(int priority_error, int affinity_error);
+
+  /**
+   * @brief Publish a scan decoded by the reactor, called from the reactor thread
+   *
+   * @param scan Scan decoded by the reactor
+   */
+  void reactorScan(SerialReactor::Scan & scan);
+
+  /**
+   * @brief Loop of the reader thread: wait for incoming bytes and receive the scans
+   * as soon as they arrive, until the node is deactivated or the port is lost
+   */
+  void readerLoop();
+
+  /**
+   * @brief Report the loss of the serial port the first time it is found, it is only
+   * opened again when the node is configured
+   *
+   * @return true if the port is lost
+   */
+  bool checkPortLost();
+
+  /**
+   * @brief Report that no scan was received within communication_timeout
+   */
+  void communicationTimeout();
+
+  /**
+   * @brief Publish the standby status if it changed, the topic is latched
    *
    * @param in_standby Standby status
    */
   void publishStandby(bool in_standby);
 
   /**
-   * @brief Publish the laser scan
+   * @brief Publish the laser scan, whose ranges and intensities are already decoded
+   * into laser_scan_
    *
-   * @param vdDistM Vector of distances in meters
-   * @param vdAngRAD Vector of angles in radians
-   * @param vdIntensAU Vector of intensities in arbitrary units
-   * @param iSickTimeStamp Timestamp of the scan
-   * @param iSickNow Current timestamp
+   * @param geometry Angles of the measurements
+   * @param iSickTimeStamp Scan number of the scan, stamped with the scanner clock model
    */
   void publishLaserScan(
-    std::vector<double> vdDistM, std::vector<double> vdAngRAD,
-    std::vector<double> vdIntensAU, unsigned int iSickTimeStamp, unsigned int iSickNow);
+    const ScannerSickS300::ScanGeometry & geometry, unsigned int iSickTimeStamp);
+
+  /**
+   * @brief Publish the measurements decoded into laser_scan_ as points, without the ones
+   * out of range
+   *
+   * @param geometry Angles of the measurements
+   * @param iSickTimeStamp Scan number of the scan, stamped with the scanner clock model
+   */
+  void publishPointCloud(
+    const ScannerSickS300::ScanGeometry & geometry, unsigned int iSickTimeStamp);
 
   /**
-   * @brief Publish an error message
+   * @brief Add a scan to the totals of the diagnostics and copy the counters of the scanner,
+   * called from the reader
    *
-   * @param error Error message
+   * @param in_standby Whether the scanner was in standby
    */
-  void publishError(std::string error);
+  void updateDiagnostics(bool in_standby);
 
   /**
-   * @brief Publish a warning message
+   * @brief Copy the counters of the scanner and of the clock model into the totals
    *
-   * @param warn Warning message
+   * @param totals Totals of the diagnostics
+   */
+  void readScannerTotals(DiagnosticTotals & totals) const;
+
+  /**
+   * @brief Publish the diagnostics of the scans received since the previous call
+   */
+  void publishDiagnostics();
+
+  /**
+   * @brief Add the latencies of the stages of the scan just published to the histograms
+   */
+  void recordLatency();
+
+  /**
+   * @brief Publish the percentiles of the latencies recorded since the previous call
+   * and clear the histograms
    */
-  void publishWarn(std::string warn);
+  void publishLatency();
 
-  rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::LaserScan>::SharedPtr laser_scan_pub_;
+  /**
+   * @brief Stamp of a scan from its scan number, with the scanner clock model
+   *
+   * @param iSickTimeStamp Scan number of the scan
+   * @return Time of the first measurement of the scan
+   */
+  rclcpp::Time getScanStamp(unsigned int iSickTimeStamp);
+
+  /**
+   * @brief Publish the reflector and I/O telegrams decoded together with the scans
+   */
+  void publishAuxiliary();
+
+  /**
+   * @brief Take a new message to decode the next scan into, after the previous one
+   * was handed over to the intra-process subscriptions
+   */
+  void resetScanMessage();
+
+  /**
+   * @brief Same as resetScanMessage for the points of the scans
+   */
+  void resetPointCloudMessage();
+
+  // The scan topic is published by the first active field, the others have their own one.
+  // Only set for the active fields, and if the LaserScan is published.
+  rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::LaserScan>::SharedPtr
+    laser_scan_pubs_[ScannerSickS300::MAX_FIELDS];
+  // Same for the points of the scans
+  rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::PointCloud2>::SharedPtr
+    point_cloud_pubs_[ScannerSickS300::MAX_FIELDS];
   rclcpp_lifecycle::LifecyclePublisher<std_msgs::msg::Bool>::SharedPtr in_standby_pub_;
   rclcpp_lifecycle::LifecyclePublisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diag_pub_;
-  rclcpp::TimerBase::SharedPtr timer_;
+  rclcpp_lifecycle::LifecyclePublisher<diagnostic_msgs::msg::DiagnosticStatus>::SharedPtr
+    latency_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<geometry_msgs::msg::PoseArray>::SharedPtr reflectors_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<std_msgs::msg::UInt16MultiArray>::SharedPtr io_pub_;
+  rclcpp::TimerBase::SharedPtr timer_, autostart_timer_, latency_timer_, diag_timer_;
+  std::thread reader_thread_;
+  std::atomic<bool> reader_running_;
+  std::atomic<bool> port_lost_;
+  std::shared_ptr<SerialReactor> reactor_;
 
-  std::string frame_id_, scan_topic_, port_;
+  std::string frame_id_, scan_topic_, port_, acquisition_mode_, capture_file_;
   int baud_, scan_id_;
-  bool inverted_, debug_, synced_time_ready_;
-  unsigned int synced_sick_stamp_;
+  bool inverted_, debug_, publish_all_scans_, autostart_, low_latency_, adaptive_reads_;
+  bool latency_stats_, lock_memory_, publish_laser_scan_, publish_point_cloud_;
+  int realtime_priority_;
+  std::vector<int64_t> cpu_affinity_;
+  // Whether the settings of the operating system were applied, for the diagnostics
+  std::string priority_status_, affinity_status_;   // guarded by diag_mutex_
+  std::string memory_status_;
   double scan_duration_, scan_cycle_time_, scan_delay_, communication_timeout_;
+  double latency_stats_period_, diagnostics_period_;
   std_msgs::msg::Bool in_standby_;
-  rclcpp::Time synced_ros_time_;
+  // Reused for every reflector and I/O telegram
+  geometry_msgs::msg::PoseArray reflectors_msg_;
+  std_msgs::msg::UInt16MultiArray io_msg_;
+  bool standby_published_;
+  std::mutex diag_mutex_;
+  DiagnosticTotals diag_totals_;       // guarded by diag_mutex_
+  DiagnosticTotals last_diag_totals_;  // totals at the previous publication
+  rclcpp::Time last_diag_time_;
+  // Message the next scan is decoded into. It is reused for every scan unless its
+  // ownership is passed to the intra-process subscriptions.
+  std::unique_ptr<sensor_msgs::msg::LaserScan> laser_scan_;
+  // Same for the points, its data keeps the capacity of the longest scan
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> point_cloud_;
+  // Maps the scan numbers to host time
+  ScanClock scan_clock_;
+  // Latencies of the stages of the scans, from the first byte read to the publish
+  enum LatencyStage
+  {
+    LATENCY_TRANSFER,           // first byte to last byte of the telegram read
+    LATENCY_FRAMING,            // last byte read to telegram framed and checked
+    LATENCY_DECODE,             // telegram checked to measurements converted
+    LATENCY_PUBLISH,            // measurements converted to publish returned
+    LATENCY_TOTAL,              // first byte read to publish returned
+    NUM_LATENCY_STAGES
+  };
+  LatencyHistogram latency_[NUM_LATENCY_STAGES];
+  // Last time a scan was received, to detect a communication timeout
+  rclcpp::Time last_communication_time_;
   ScannerSickS300 scanner_;
 };
 
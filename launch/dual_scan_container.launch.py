@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 Alberto J. Tudela Roldán
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Launches a front and a rear Sick S300 laser scanner in the same component container."""
+
+import os
+
+from ament_index_python import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+
+def generate_launch_description():
+    # Default filenames and where to find them
+    sicks300_dir = get_package_share_directory('sicks300_ros2')
+
+    # Read the YAML parameters file.
+    default_sicks300_param_file = os.path.join(sicks300_dir, 'params', 'dual.yaml')
+
+    # Create the launch configuration variables.
+    sicks300_param_file = LaunchConfiguration(
+        'sicks300_param_file', default=default_sicks300_param_file)
+
+    # Map these variables to arguments: can be set from the command line or a default will be used
+    sicks300_param_file_launch_arg = DeclareLaunchArgument(
+        'sicks300_param_file',
+        default_value=default_sicks300_param_file,
+        description='Full path to the Sicks300 parameter file to use'
+    )
+
+    declare_log_level_arg = DeclareLaunchArgument(
+        name='log-level',
+        default_value='info',
+        description='Logging level (info, debug, ...)'
+    )
+
+    # Both drivers share one process, one executor and one serial reader thread (the
+    # reactor), and configure and activate themselves (autostart in the parameters).
+    container = ComposableNodeContainer(
+        name='laser_container',
+        namespace='',
+        package='rclcpp_components',
+        executable='component_container',
+        composable_node_descriptions=[
+            ComposableNode(
+                package='sicks300_ros2',
+                plugin='sicks300_ros2::SickS300',
+                name=name,
+                parameters=[sicks300_param_file],
+                extra_arguments=[{'use_intra_process_comms': True}])
+            for name in ['laser_front', 'laser_rear']
+        ],
+        emulate_tty=True,
+        output='screen',
+        arguments=[
+            '--ros-args',
+            '--log-level', LaunchConfiguration('log-level')]
+    )
+
+    return LaunchDescription([
+        sicks300_param_file_launch_arg,
+        declare_log_level_arg,
+        container,
+    ])
@@ -0,0 +1,227 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sicks300_ros2/common/Crc16.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRC16_HAVE_CLMUL
+#endif
+
+namespace
+{
+
+constexpr uint16_t crc_LookUpTable[256] =
+{
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+
+// Slicing tables: crc_SliceTables[k][b] is the CRC of byte b followed by k zero bytes
+struct SliceTables
+{
+  uint16_t t[8][256];
+};
+
+constexpr SliceTables makeSliceTables()
+{
+  SliceTables tables{};
+  for (int b = 0; b < 256; b++) {
+    tables.t[0][b] = crc_LookUpTable[b];
+  }
+  for (int k = 1; k < 8; k++) {
+    for (int b = 0; b < 256; b++) {
+      uint16_t prev = tables.t[k - 1][b];
+      tables.t[k][b] = static_cast<uint16_t>((prev << 8) ^ tables.t[0][prev >> 8]);
+    }
+  }
+  return tables;
+}
+
+constexpr SliceTables crc_SliceTables = makeSliceTables();
+
+uint16_t updateBytewise(uint16_t crc, const uint8_t * data, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    crc = (crc << 8) ^ crc_LookUpTable[((uint8_t)(crc >> 8)) ^ data[i]];
+  }
+  return crc;
+}
+
+uint16_t updateSliceBy8(uint16_t crc, const uint8_t * data, size_t size)
+{
+  const uint16_t (* t)[256] = crc_SliceTables.t;
+  while (size >= 8) {
+    crc = t[7][data[0] ^ (crc >> 8)] ^ t[6][data[1] ^ (crc & 0xFF)] ^
+      t[5][data[2]] ^ t[4][data[3]] ^ t[3][data[4]] ^ t[2][data[5]] ^
+      t[1][data[6]] ^ t[0][data[7]];
+    data += 8;
+    size -= 8;
+  }
+  return updateBytewise(crc, data, size);
+}
+
+#ifdef CRC16_HAVE_CLMUL
+// x^n mod P, used to move a 128 bit block n bits forward
+constexpr uint64_t xPowModP(unsigned int n)
+{
+  uint32_t r = 1;
+  for (unsigned int i = 0; i < n; i++) {
+    r <<= 1;
+    if (r & 0x10000) {r ^= 0x11021;}
+  }
+  return r;
+}
+
+// Returns x * x^bits + data, reduced to 128 bits, for x = hi * x^64 + lo
+__attribute__((target("pclmul,ssse3")))
+inline __m128i fold(__m128i x, __m128i k, __m128i data)
+{
+  return _mm_xor_si128(
+    _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00)), data);
+}
+
+__attribute__((target("pclmul,ssse3")))
+uint16_t updateClmul(uint16_t crc, const uint8_t * data, size_t size)
+{
+  if (size < 64) {return updateSliceBy8(crc, data, size);}
+
+  // The telegram is processed as a big endian polynomial
+  const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const __m128i k512 = _mm_set_epi64x(xPowModP(512 + 64), xPowModP(512));
+  const __m128i k128 = _mm_set_epi64x(xPowModP(128 + 64), xPowModP(128));
+  const __m128i * blocks = reinterpret_cast<const __m128i *>(data);
+
+  // Four independent lanes of 16 bytes, the CRC so far goes in front of the first one
+  __m128i x0 = _mm_shuffle_epi8(_mm_loadu_si128(blocks + 0), bswap);
+  __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128(blocks + 1), bswap);
+  __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128(blocks + 2), bswap);
+  __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128(blocks + 3), bswap);
+  x0 = _mm_xor_si128(x0, _mm_set_epi64x(static_cast<int64_t>(crc) << 48, 0));
+  blocks += 4;
+  size -= 64;
+
+  while (size >= 64) {
+    x0 = fold(x0, k512, _mm_shuffle_epi8(_mm_loadu_si128(blocks + 0), bswap));
+    x1 = fold(x1, k512, _mm_shuffle_epi8(_mm_loadu_si128(blocks + 1), bswap));
+    x2 = fold(x2, k512, _mm_shuffle_epi8(_mm_loadu_si128(blocks + 2), bswap));
+    x3 = fold(x3, k512, _mm_shuffle_epi8(_mm_loadu_si128(blocks + 3), bswap));
+    blocks += 4;
+    size -= 64;
+  }
+
+  // Merge the lanes and the remaining whole blocks
+  x0 = fold(x0, k128, x1);
+  x0 = fold(x0, k128, x2);
+  x0 = fold(x0, k128, x3);
+  while (size >= 16) {
+    x0 = fold(x0, k128, _mm_shuffle_epi8(_mm_loadu_si128(blocks), bswap));
+    blocks++;
+    size -= 16;
+  }
+
+  // The CRC of the folded block, started from zero, is the CRC of everything before
+  uint8_t folded[16];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(folded), _mm_shuffle_epi8(x0, bswap));
+  crc = updateSliceBy8(0, folded, sizeof(folded));
+
+  return updateSliceBy8(crc, reinterpret_cast<const uint8_t *>(blocks), size);
+}
+#endif
+
+}  // namespace
+
+uint16_t Crc16::update(Engine engine, uint16_t crc, const uint8_t * data, size_t size)
+{
+  switch (engine) {
+#ifdef CRC16_HAVE_CLMUL
+    case CLMUL: return updateClmul(crc, data, size);
+#endif
+    case SLICE_BY_8: return updateSliceBy8(crc, data, size);
+    default: return updateBytewise(crc, data, size);
+  }
+}
+
+bool Crc16::isSupported(Engine engine)
+{
+  switch (engine) {
+    case BYTEWISE:
+    case SLICE_BY_8:
+      return true;
+    case CLMUL:
+#ifdef CRC16_HAVE_CLMUL
+      return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+Crc16::Engine Crc16::getBestEngine()
+{
+  return isSupported(CLMUL) ? CLMUL : SLICE_BY_8;
+}
+
+const char * Crc16::getName(Engine engine)
+{
+  switch (engine) {
+    case BYTEWISE: return "bytewise";
+    case SLICE_BY_8: return "slice-by-8";
+    case CLMUL: return "clmul";
+    default: return "unknown";
+  }
+}
+
+Crc16::UpdateFunction Crc16::getUpdateFunction()
+{
+  static const UpdateFunction function = []() -> UpdateFunction {
+#ifdef CRC16_HAVE_CLMUL
+      if (getBestEngine() == CLMUL) {return updateClmul;}
+#endif
+      return updateSliceBy8;
+    }();
+  return function;
+}
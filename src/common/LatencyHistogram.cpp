@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sicks300_ros2/common/LatencyHistogram.hpp"
+
+LatencyHistogram::LatencyHistogram()
+: max_(0)
+{
+  for (auto & count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t LatencyHistogram::getBucket(uint64_t value)
+{
+  if (value < SUB_BUCKETS) {return static_cast<size_t>(value);}
+
+  const uint64_t limit = (uint64_t(1) << MAX_BITS) - 1;
+  if (value > limit) {value = limit;}
+
+  // The leading bit selects the power of two, the next ones the sub-bucket
+  int exponent = 63 - __builtin_clzll(value);
+  int shift = exponent - SUB_BUCKET_BITS;
+  size_t sub_bucket = static_cast<size_t>(value >> shift) - SUB_BUCKETS;
+  return static_cast<size_t>(shift + 1) * SUB_BUCKETS + sub_bucket;
+}
+
+int64_t LatencyHistogram::getBucketValue(size_t bucket)
+{
+  if (bucket < SUB_BUCKETS) {return static_cast<int64_t>(bucket);}
+
+  int shift = static_cast<int>(bucket / SUB_BUCKETS) - 1;
+  uint64_t lowest = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+  return static_cast<int64_t>(lowest + ((uint64_t(1) << shift) >> 1));
+}
+
+void LatencyHistogram::record(int64_t value_ns)
+{
+  if (value_ns < 0) {value_ns = 0;}
+  counts_[getBucket(static_cast<uint64_t>(value_ns))].fetch_add(1, std::memory_order_relaxed);
+
+  int64_t max = max_.load(std::memory_order_relaxed);
+  while (value_ns > max &&
+    !max_.compare_exchange_weak(max, value_ns, std::memory_order_relaxed))
+  {
+  }
+}
+
+LatencyHistogram::Summary LatencyHistogram::collect()
+{
+  uint32_t counts[NUM_BUCKETS];
+  Summary summary = {0, 0, 0, 0};
+  for (size_t i = 0; i < NUM_BUCKETS; i++) {
+    counts[i] = counts_[i].exchange(0, std::memory_order_relaxed);
+    summary.count += counts[i];
+  }
+  summary.max = max_.exchange(0, std::memory_order_relaxed);
+  if (summary.count == 0) {return summary;}
+
+  // Smallest values reaching the ranks of the percentiles
+  uint64_t rank50 = (summary.count + 1) / 2;
+  uint64_t rank99 = summary.count - summary.count / 100;
+  uint64_t total = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; i++) {
+    if (counts[i] == 0) {continue;}
+    // The median is found in the first bucket reaching its rank, even if its value is 0
+    bool below_median = total < rank50;
+    total += counts[i];
+    if (below_median && total >= rank50) {
+      summary.p50 = getBucketValue(i);
+    }
+    if (total >= rank99) {
+      summary.p99 = getBucketValue(i);
+      break;
+    }
+  }
+
+  // The middle of the last bucket may be above the exact maximum
+  if (summary.p50 > summary.max) {summary.p50 = summary.max;}
+  if (summary.p99 > summary.max) {summary.p99 = summary.max;}
+  return summary;
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <alloca.h>
+#include <errno.h>
+#include <malloc.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "sicks300_ros2/common/RealTime.hpp"
+
+int RealTime::setPriority(pthread_t thread, int priority)
+{
+  int policy = priority > 0 ? SCHED_FIFO : SCHED_OTHER;
+  if (priority < 0 || priority > sched_get_priority_max(policy)) {return EINVAL;}
+
+  sched_param param;
+  memset(&param, 0, sizeof(param));
+  param.sched_priority = priority;
+  return pthread_setschedparam(thread, policy, &param);
+}
+
+int RealTime::setAffinity(pthread_t thread, const std::vector<int> & cpus)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (cpus.empty()) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {return EINVAL;}
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(thread, sizeof(set), &set);
+}
+
+int RealTime::lockMemory(size_t stack_size)
+{
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {return errno;}
+
+  // Large blocks would be mapped and unmapped on every allocation, and the top of the
+  // heap trimmed, each time faulting the pages in again
+  mallopt(M_MMAP_MAX, 0);
+  mallopt(M_TRIM_THRESHOLD, -1);
+
+  // The pages of the stack below the current frame are only mapped when first touched
+  unsigned char * stack = static_cast<unsigned char *>(alloca(stack_size));
+  volatile unsigned char * touch = stack;
+  for (size_t i = 0; i < stack_size; i += 4096) {
+    touch[i] = 0;
+  }
+  return 0;
+}
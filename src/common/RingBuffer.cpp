@@ -0,0 +1,87 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include "sicks300_ros2/common/RingBuffer.hpp"
+
+RingBuffer::RingBuffer(size_t capacity, size_t mirror)
+: head_(0),
+  tail_(0)
+{
+  capacity_ = 1;
+  while (capacity_ < capacity) {
+    capacity_ <<= 1;
+  }
+  mask_ = capacity_ - 1;
+  mirror_ = mirror < capacity_ ? mirror : capacity_;
+  data_.resize(capacity_ + mirror_);
+}
+
+unsigned char * RingBuffer::writeView(size_t & length)
+{
+  size_t index = head_ & mask_;
+  size_t until_end = capacity_ - index;
+  length = space() < until_end ? space() : until_end;
+  return data_.data() + index;
+}
+
+unsigned char * RingBuffer::writeView(
+  size_t & length, unsigned char * & wrapped, size_t & wrapped_length)
+{
+  unsigned char * view = writeView(length);
+  wrapped = data_.data();
+  wrapped_length = space() - length;
+  return view;
+}
+
+void RingBuffer::commit(size_t count)
+{
+  while (count > 0) {
+    size_t index = head_ & mask_;
+    size_t until_end = capacity_ - index;
+    size_t part = count < until_end ? count : until_end;
+    // Keep the copy of the first bytes after the end of the storage
+    if (index < mirror_) {
+      size_t mirrored = index + part < mirror_ ? part : mirror_ - index;
+      memcpy(data_.data() + capacity_ + index, data_.data() + index, mirrored);
+    }
+    head_ += part;
+    count -= part;
+  }
+}
+
+size_t RingBuffer::write(const unsigned char * data, size_t length)
+{
+  size_t written = 0;
+  while (written < length) {
+    size_t view_length;
+    unsigned char * view = writeView(view_length);
+    if (view_length == 0) {break;}
+    size_t count = length - written < view_length ? length - written : view_length;
+    memcpy(view, data + written, count);
+    commit(count);
+    written += count;
+  }
+  return written;
+}
+
+const unsigned char * RingBuffer::readView(size_t position, size_t & length) const
+{
+  size_t index = position & mask_;
+  size_t until_end = capacity_ + mirror_ - index;
+  size_t available = head_ - position;
+  length = available < until_end ? available : until_end;
+  return data_.data() + index;
+}
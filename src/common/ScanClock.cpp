@@ -0,0 +1,151 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+
+#include "sicks300_ros2/common/ScanClock.hpp"
+
+namespace
+{
+
+// Samples later than the model by more than 3 sigma plus this margin are rejected
+const double c_dMinJitterMargin = 0.0005;
+
+// Tolerance of the fitted period around the nominal one
+const double c_dMaxPeriodError = 0.1;
+
+}  // namespace
+
+ScanClock::ScanClock(double nominal_period, size_t window)
+: nominal_period_(nominal_period),
+  rejected_(0)
+{
+  samples_.resize(window > MIN_SAMPLES ? window : static_cast<size_t>(MIN_SAMPLES));
+  reset();
+}
+
+void ScanClock::reset()
+{
+  num_samples_ = 0;
+  next_sample_ = 0;
+  last_scan_number_ = 0;
+  last_ticks_ = 0.0;
+  origin_ns_ = 0;
+  intercept_ = 0.0;
+  slope_ = nominal_period_;
+  envelope_ = 0.0;
+  jitter_ = 0.0;
+  rejected_in_row_ = 0;
+}
+
+bool ScanClock::update(unsigned int scan_number, int64_t arrival_ns)
+{
+  if (num_samples_ > 0) {
+    int diff = static_cast<int>(scan_number - last_scan_number_);
+
+    // Several fields share the same scan number, only the first one is a sample
+    if (diff == 0) {return true;}
+
+    if (diff < 0 || diff > MAX_SCAN_GAP) {
+      reset();
+    }
+  }
+
+  if (num_samples_ == 0) {
+    origin_ns_ = arrival_ns;
+    last_ticks_ = 0.0;
+  } else {
+    last_ticks_ += static_cast<int>(scan_number - last_scan_number_);
+  }
+  last_scan_number_ = scan_number;
+
+  Sample sample;
+  sample.ticks = last_ticks_;
+  sample.time = static_cast<double>(arrival_ns - origin_ns_) * 1e-9;
+
+  // Reject the samples delayed by the scheduling of the reader
+  if (isReady()) {
+    double residual = sample.time - (intercept_ + slope_ * sample.ticks);
+    if (residual > 3.0 * jitter_ + c_dMinJitterMargin) {
+      rejected_++;
+      if (++rejected_in_row_ > MAX_REJECTED) {
+        reset();
+      }
+      return false;
+    }
+  }
+  rejected_in_row_ = 0;
+
+  samples_[next_sample_] = sample;
+  next_sample_ = (next_sample_ + 1) % samples_.size();
+  if (num_samples_ < samples_.size()) {
+    num_samples_++;
+  }
+
+  fit();
+
+  if (isReady() && fabs(slope_ - nominal_period_) > c_dMaxPeriodError * nominal_period_) {
+    reset();
+  }
+
+  return true;
+}
+
+int64_t ScanClock::toTime(unsigned int scan_number) const
+{
+  double ticks = last_ticks_ + static_cast<int>(scan_number - last_scan_number_);
+  double time = intercept_ + envelope_ + slope_ * ticks;
+  return origin_ns_ + static_cast<int64_t>(llround(time * 1e9));
+}
+
+void ScanClock::fit()
+{
+  if (num_samples_ < 2) {
+    intercept_ = samples_[0].time - nominal_period_ * samples_[0].ticks;
+    slope_ = nominal_period_;
+    envelope_ = 0.0;
+    jitter_ = 0.0;
+    return;
+  }
+
+  // Centered sums keep the fit accurate while the origin gets far away
+  double mean_ticks = 0.0, mean_time = 0.0;
+  for (size_t i = 0; i < num_samples_; i++) {
+    mean_ticks += samples_[i].ticks;
+    mean_time += samples_[i].time;
+  }
+  mean_ticks /= num_samples_;
+  mean_time /= num_samples_;
+
+  double sxx = 0.0, sxy = 0.0;
+  for (size_t i = 0; i < num_samples_; i++) {
+    double dx = samples_[i].ticks - mean_ticks;
+    sxx += dx * dx;
+    sxy += dx * (samples_[i].time - mean_time);
+  }
+  slope_ = sxx > 0.0 ? sxy / sxx : nominal_period_;
+  intercept_ = mean_time - slope_ * mean_ticks;
+
+  // The line goes through the mean delay, the earliest arrival has the least one
+  double min_residual = 0.0, sum_squares = 0.0;
+  for (size_t i = 0; i < num_samples_; i++) {
+    double residual = samples_[i].time - (intercept_ + slope_ * samples_[i].ticks);
+    if (i == 0 || residual < min_residual) {
+      min_residual = residual;
+    }
+    sum_squares += residual * residual;
+  }
+  envelope_ = min_residual;
+  jitter_ = sqrt(sum_squares / num_samples_);
+}
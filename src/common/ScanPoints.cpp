@@ -0,0 +1,218 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sicks300_ros2/common/ScanPoints.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCANPOINTS_HAVE_SIMD
+#endif
+
+namespace
+{
+
+// The point of a beam is always stored where the next valid point goes, so the output
+// never gets ahead of the input and POINT_FIELDS * num_beams floats are enough
+size_t convertScalar(
+  const float * ranges, const float * intensities, const float * sin_table,
+  const float * cos_table, size_t num_beams, float range_min, float range_max,
+  float * points)
+{
+  float * out = points;
+  for (size_t i = 0; i < num_beams; i++) {
+    float range = ranges[i];
+    out[0] = range * cos_table[i];
+    out[1] = range * sin_table[i];
+    out[2] = 0.0f;
+    out[3] = intensities[i];
+    out += ScanPoints::POINT_FIELDS * (range >= range_min && range <= range_max);
+  }
+  return static_cast<size_t>(out - points) / ScanPoints::POINT_FIELDS;
+}
+
+#ifdef SCANPOINTS_HAVE_SIMD
+
+// Writes the 4 beams of x, y and intensity as 4 points, skipping the ones not in mask
+__attribute__((target("sse2")))
+inline float * storePoints(float * out, __m128 x, __m128 y, __m128 intensity, int mask)
+{
+  __m128 z = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(x, y, z, intensity);
+  _mm_storeu_ps(out, x);
+  out += ScanPoints::POINT_FIELDS * (mask & 1);
+  _mm_storeu_ps(out, y);
+  out += ScanPoints::POINT_FIELDS * ((mask >> 1) & 1);
+  _mm_storeu_ps(out, z);
+  out += ScanPoints::POINT_FIELDS * ((mask >> 2) & 1);
+  _mm_storeu_ps(out, intensity);
+  out += ScanPoints::POINT_FIELDS * ((mask >> 3) & 1);
+  return out;
+}
+
+__attribute__((target("sse2")))
+size_t convertSse(
+  const float * ranges, const float * intensities, const float * sin_table,
+  const float * cos_table, size_t num_beams, float range_min, float range_max,
+  float * points)
+{
+  const __m128 min = _mm_set1_ps(range_min);
+  const __m128 max = _mm_set1_ps(range_max);
+  float * out = points;
+  size_t i = 0;
+  for (; i + 4 <= num_beams; i += 4) {
+    __m128 range = _mm_loadu_ps(ranges + i);
+    __m128 x = _mm_mul_ps(range, _mm_loadu_ps(cos_table + i));
+    __m128 y = _mm_mul_ps(range, _mm_loadu_ps(sin_table + i));
+    __m128 valid = _mm_and_ps(_mm_cmpge_ps(range, min), _mm_cmple_ps(range, max));
+    out = storePoints(out, x, y, _mm_loadu_ps(intensities + i), _mm_movemask_ps(valid));
+  }
+
+  size_t count = static_cast<size_t>(out - points) / ScanPoints::POINT_FIELDS;
+  return count + convertScalar(
+    ranges + i, intensities + i, sin_table + i, cos_table + i, num_beams - i, range_min,
+    range_max, out);
+}
+
+__attribute__((target("avx2")))
+size_t convertAvx2(
+  const float * ranges, const float * intensities, const float * sin_table,
+  const float * cos_table, size_t num_beams, float range_min, float range_max,
+  float * points)
+{
+  const __m256 min = _mm256_set1_ps(range_min);
+  const __m256 max = _mm256_set1_ps(range_max);
+  const __m256 zero = _mm256_setzero_ps();
+  float * out = points;
+  size_t i = 0;
+  for (; i + 8 <= num_beams; i += 8) {
+    __m256 range = _mm256_loadu_ps(ranges + i);
+    __m256 x = _mm256_mul_ps(range, _mm256_loadu_ps(cos_table + i));
+    __m256 y = _mm256_mul_ps(range, _mm256_loadu_ps(sin_table + i));
+    __m256 intensity = _mm256_loadu_ps(intensities + i);
+    __m256 valid = _mm256_and_ps(
+      _mm256_cmp_ps(range, min, _CMP_GE_OQ), _mm256_cmp_ps(range, max, _CMP_LE_OQ));
+    int mask = _mm256_movemask_ps(valid);
+
+    // Interleaving within the lanes gives the points 0 to 3 in the low lanes and 4 to 7 in
+    // the high ones, with half the shuffles of a 4x4 transposition
+    __m256 xy_low = _mm256_unpacklo_ps(x, y);
+    __m256 xy_high = _mm256_unpackhi_ps(x, y);
+    __m256 zi_low = _mm256_unpacklo_ps(zero, intensity);
+    __m256 zi_high = _mm256_unpackhi_ps(zero, intensity);
+    __m256 p0 = _mm256_castpd_ps(
+      _mm256_unpacklo_pd(_mm256_castps_pd(xy_low), _mm256_castps_pd(zi_low)));
+    __m256 p1 = _mm256_castpd_ps(
+      _mm256_unpackhi_pd(_mm256_castps_pd(xy_low), _mm256_castps_pd(zi_low)));
+    __m256 p2 = _mm256_castpd_ps(
+      _mm256_unpacklo_pd(_mm256_castps_pd(xy_high), _mm256_castps_pd(zi_high)));
+    __m256 p3 = _mm256_castpd_ps(
+      _mm256_unpackhi_pd(_mm256_castps_pd(xy_high), _mm256_castps_pd(zi_high)));
+
+    // The low lanes go first, as the last invalid one is overwritten by the high lanes
+    _mm_storeu_ps(out, _mm256_castps256_ps128(p0));
+    out += ScanPoints::POINT_FIELDS * (mask & 1);
+    _mm_storeu_ps(out, _mm256_castps256_ps128(p1));
+    out += ScanPoints::POINT_FIELDS * ((mask >> 1) & 1);
+    _mm_storeu_ps(out, _mm256_castps256_ps128(p2));
+    out += ScanPoints::POINT_FIELDS * ((mask >> 2) & 1);
+    _mm_storeu_ps(out, _mm256_castps256_ps128(p3));
+    out += ScanPoints::POINT_FIELDS * ((mask >> 3) & 1);
+    _mm_storeu_ps(out, _mm256_extractf128_ps(p0, 1));
+    out += ScanPoints::POINT_FIELDS * ((mask >> 4) & 1);
+    _mm_storeu_ps(out, _mm256_extractf128_ps(p1, 1));
+    out += ScanPoints::POINT_FIELDS * ((mask >> 5) & 1);
+    _mm_storeu_ps(out, _mm256_extractf128_ps(p2, 1));
+    out += ScanPoints::POINT_FIELDS * ((mask >> 6) & 1);
+    _mm_storeu_ps(out, _mm256_extractf128_ps(p3, 1));
+    out += ScanPoints::POINT_FIELDS * ((mask >> 7) & 1);
+  }
+
+  // The remaining beams are converted by SSE code, which is slowed down by dirty upper halves
+  _mm256_zeroupper();
+  size_t count = static_cast<size_t>(out - points) / ScanPoints::POINT_FIELDS;
+  return count + convertScalar(
+    ranges + i, intensities + i, sin_table + i, cos_table + i, num_beams - i, range_min,
+    range_max, out);
+}
+
+#endif  // SCANPOINTS_HAVE_SIMD
+
+}  // namespace
+
+size_t ScanPoints::convert(
+  Engine engine, const float * ranges, const float * intensities, const float * sin_table,
+  const float * cos_table, size_t num_beams, float range_min, float range_max,
+  float * points)
+{
+  switch (engine) {
+#ifdef SCANPOINTS_HAVE_SIMD
+    case AVX2:
+      return convertAvx2(
+        ranges, intensities, sin_table, cos_table, num_beams, range_min, range_max, points);
+    case SSE:
+      return convertSse(
+        ranges, intensities, sin_table, cos_table, num_beams, range_min, range_max, points);
+#endif
+    default:
+      return convertScalar(
+        ranges, intensities, sin_table, cos_table, num_beams, range_min, range_max, points);
+  }
+}
+
+bool ScanPoints::isSupported(Engine engine)
+{
+  switch (engine) {
+    case SCALAR:
+      return true;
+#ifdef SCANPOINTS_HAVE_SIMD
+    case SSE:
+      return __builtin_cpu_supports("sse2");
+    case AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+ScanPoints::Engine ScanPoints::getBestEngine()
+{
+  if (isSupported(AVX2)) {return AVX2;}
+  return isSupported(SSE) ? SSE : SCALAR;
+}
+
+const char * ScanPoints::getName(Engine engine)
+{
+  switch (engine) {
+    case SCALAR: return "scalar";
+    case SSE: return "sse";
+    case AVX2: return "avx2";
+    default: return "unknown";
+  }
+}
+
+ScanPoints::ConvertFunction ScanPoints::getConvertFunction()
+{
+  static const ConvertFunction function = []() -> ConvertFunction {
+#ifdef SCANPOINTS_HAVE_SIMD
+      switch (getBestEngine()) {
+        case AVX2: return convertAvx2;
+        case SSE: return convertSse;
+        default: break;
+      }
+#endif
+      return convertScalar;
+    }();
+  return function;
+}
@@ -14,77 +14,79 @@
  * limitations under the License.
  */
 
+#include <errno.h>
 #include <stdint.h>
+#include <chrono>
+#include "sicks300_ros2/common/Crc16.hpp"
 #include "sicks300_ros2/common/ScannerSickS300.hpp"
 
 //-----------------------------------------------
 
 typedef unsigned char BYTE;
 
+namespace
+{
+
+// Larger jumps of the scan number, including backward ones, are a restart of the scanner
+// rather than lost scans, as ScanClock does with MAX_SCAN_GAP. 0x10000 scans are about 44 min.
+const unsigned int c_iMaxSkippedScans = 0x10000;
+
+}  // namespace
+
 const double ScannerSickS300::c_dPi = 3.14159265358979323846;
-unsigned char ScannerSickS300::m_iScanId = 7;
-
-const uint16_t crc_LookUpTable[256] =
-{
-  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
-};
 
 unsigned int TelegramParser::createCRC(uint8_t * ptrData, int Size)
 {
-  int CounterWord;
-  uint16_t CrcValue = 0xFFFF;
-
-  for (CounterWord = 0; CounterWord < Size; CounterWord++) {
-    CrcValue = (CrcValue << 8) ^ crc_LookUpTable[(((uint8_t)(CrcValue >> 8)) ^ *ptrData)];
-    ptrData++;
-  }
+  return updateCRC(0xFFFF, ptrData, Size);
+}
 
-  return CrcValue;
+uint16_t TelegramParser::updateCRC(uint16_t crc, const uint8_t * ptrData, size_t Size)
+{
+  return Crc16::update(crc, ptrData, Size);
 }
 
 //-----------------------------------------------
 ScannerSickS300::ScannerSickS300()
+: m_RxBuf(READ_BUF_SIZE, TelegramFramer::MAX_TELEGRAM_SIZE)
 {
   // allows to set different Baud-Multipliers depending on used SerialIO-Card
   m_dBaudMult = 1.0;
-
-  // init scan with zeros
-  m_iPosReadBuf2 = 0;
-
-  m_actualBufferSize = 0;
+  m_iBaudRate = 0;
+  m_dByteTime = 0.0;
+  m_bAdaptiveReads = false;
+
+  m_iScanId = 7;
+
+  m_uiDroppedTelegrams = 0;
+  m_uiReceivedTelegrams = 0;
+  m_uiLastTelegramLength = 0;
+  m_uiLastTelegramEnd = 0;
+  m_uiResyncs = 0;
+  m_uiSkippedScans = 0;
+  m_uiLastReceivedScanNumber = 0;
+  m_uiLastReadScanNumber = 0;
+  m_bScanNumberValid = false;
+  clearTelegrams();
 
   m_bInStandby = true;
+  m_bPortLost = false;
+  m_uiCaptureStart = 0;
+
+  m_bLatencyStats = false;
+  m_iNextReadTime = 0;
+  for (ReadTime & read : m_ReadTimes) {
+    read.end = 0;
+    read.time_ns = 0;
+  }
+  m_ScanTimes = ScanTimes();
+
+  clearFields();
+  m_iLastField = 0;
+  m_Reflectors.iScanNumber = 0;
+  m_Reflectors.vReflectors.reserve(MAX_REFLECTORS);
+  m_Io.iScanNumber = 0;
+  m_Io.viWords.reserve(MAX_IO_WORDS);
+  m_bNewReflectors = m_bNewIo = false;
 }
 
 
@@ -102,8 +104,10 @@ bool ScannerSickS300::open(const char * pcPort, int iBaudRate, int iScanId = 7)
 
   // update scan id (id=8 for slave scanner, else 7)
   m_iScanId = iScanId;
+  m_Framer.setDeviceAddress(m_iScanId);
 
   // initialize Serial Interface
+  m_bPortLost = false;
   m_SerialIO.setBaudRate(iBaudRate);
   m_SerialIO.setDeviceName(pcPort);
   m_SerialIO.setBufferSize(READ_BUF_SIZE - 10, WRITE_BUF_SIZE - 10);
@@ -115,7 +119,15 @@ bool ScannerSickS300::open(const char * pcPort, int iBaudRate, int iScanId = 7)
 
   if (bRetSerial == 0) {
     // Clears the read and transmit buffer.
-    m_iPosReadBuf2 = 0;
+    clearTelegrams();
+    m_uiDroppedTelegrams = 0;
+    m_uiReceivedTelegrams = 0;
+    m_uiResyncs = 0;
+    m_uiSkippedScans = 0;
+    m_bScanNumberValid = false;
+    m_iBaudRate = static_cast<int>(iBaudRate * m_dBaudMult + 0.5);
+    // start, 8 data bits and stop
+    m_dByteTime = 10.0 / (iBaudRate * m_dBaudMult);
     m_SerialIO.purge();
     return true;
   } else {
@@ -127,7 +139,7 @@ bool ScannerSickS300::open(const char * pcPort, int iBaudRate, int iScanId = 7)
 //-------------------------------------------
 void ScannerSickS300::purgeScanBuf()
 {
-  m_iPosReadBuf2 = 0;
+  clearTelegrams();
   m_SerialIO.purge();
 }
 
@@ -151,94 +163,541 @@ void ScannerSickS300::stopScanner()
 
 //-----------------------------------------------
 bool ScannerSickS300::getScan(
-  std::vector<double> & vdDistanceM, std::vector<double> & vdAngleRAD,
-  std::vector<double> & vdIntensityAU, unsigned int & /*iTimestamp*/,
-  unsigned int & iTimeNow, const bool debug)
-{
-  bool bRet = false;
-  int iNumRead2 = 0;
-  std::vector<ScanPolarType> vecScanPolar;
-
-  iTimeNow = 0;
-
-  if (SCANNER_S300_READ_BUF_SIZE - 2 - m_actualBufferSize <= 0) {
-    m_actualBufferSize = 0;
-  }
-
-  iNumRead2 = m_SerialIO.readBlocking(
-    reinterpret_cast<char *>(m_ReadBuf) + m_actualBufferSize,
-    SCANNER_S300_READ_BUF_SIZE - 2 - m_actualBufferSize);
-  if (iNumRead2 <= 0) {return false;}
-
-  m_actualBufferSize = m_actualBufferSize + iNumRead2;
-
-  // Try to find scan. Searching backwards in the receive queue.
-  for (int i = m_actualBufferSize; i >= 0; i--) {
-    // parse through the telegram until header with correct scan id is found
-    if (tp_.parseHeader(m_ReadBuf + i, m_actualBufferSize - i, m_iScanId, debug)) {
-      tp_.readDistRaw(m_ReadBuf + i, m_viScanRaw, debug);
-      if (m_viScanRaw.size() > 0) {
-        // Scan was succesfully read from buffer
-        bRet = true;
-        int old = m_actualBufferSize;
-        m_actualBufferSize -= tp_.getCompletePacketSize() + i;
-        for (int j = 0; j < old - m_actualBufferSize; j++) {
-          m_ReadBuf[j] = m_ReadBuf[j + old - m_actualBufferSize];
-        }
-        break;
-      }
+  std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+  const ScanGeometry * & pGeometry, unsigned int & iTimestamp,
+  unsigned int & iTimeNow, const bool bInverted, const bool debug)
+{
+  if (receiveTelegrams() <= 0) {return false;}
+
+  if (!lastScan(vfDistanceM, vfIntensityAU, pGeometry, iTimestamp, bInverted, debug)) {
+    return false;
+  }
+  iTimeNow = iTimestamp;
+  return true;
+}
+
+//-----------------------------------------------
+bool ScannerSickS300::lastScan(
+  std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+  const ScanGeometry * & pGeometry, unsigned int & iScanNumber,
+  const bool bInverted, const bool debug)
+{
+  FieldType * pField;
+  const unsigned char * pTelegram;
+
+  // Look for the last scan of every configured field, only those are decoded
+  int aiNewest[MAX_FIELDS];
+  for (int & iNewest : aiNewest) {
+    iNewest = -1;
+  }
+  for (int i = 0; i < m_iNumTelegrams; i++) {
+    if (parseTelegram(i, pField, pTelegram, debug) == TELEGRAM_SCAN) {
+      aiNewest[tp_.getField() - 1] = i;
     }
   }
 
-  PARAM_MAP::const_iterator param = m_Params.find(tp_.getField());
-  if (bRet && param != m_Params.end()) {
-    // convert data into range and intensity information
-    convertScanToPolar(param, m_viScanRaw, vecScanPolar);
-
-    // resize vectors to size of Scan
-    vdDistanceM.resize(vecScanPolar.size());
-    vdAngleRAD.resize(vecScanPolar.size());
-    vdIntensityAU.resize(vecScanPolar.size());
-    // assign outputs
-    for (unsigned int i = 0; i < vecScanPolar.size(); i++) {
-      vdDistanceM[i] = vecScanPolar[i].dr;
-      vdAngleRAD[i] = vecScanPolar[i].da;
-      vdIntensityAU[i] = vecScanPolar[i].di;
+  // Drop the telegrams before the first of them
+  while (m_iNumTelegrams > 0) {
+    TelegramKind kind = parseTelegram(0, pField, pTelegram, debug);
+    bool bNewest = kind == TELEGRAM_SCAN && aiNewest[tp_.getField() - 1] == 0;
+
+    if (kind == TELEGRAM_SCAN) {
+      iScanNumber = tp_.getScanNumber();
+      countSkippedScans(iScanNumber);
+    }
+    if (bNewest) {
+      convertScanToPolar(
+        *pField, pTelegram, vfDistanceM, vfIntensityAU, pGeometry, bInverted);
+      stampScan(0);
+    } else {
+      decodeAuxiliary(kind, pTelegram, bInverted);
+    }
+    popTelegram();
+    for (int & iNewest : aiNewest) {
+      iNewest--;
+    }
+
+    if (bNewest) {
+      popAuxiliary(iScanNumber, bInverted, debug);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//-----------------------------------------------
+bool ScannerSickS300::nextScan(
+  std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+  const ScanGeometry * & pGeometry, unsigned int & iScanNumber,
+  const bool bInverted, const bool debug)
+{
+  while (m_iNumTelegrams > 0) {
+    FieldType * pField;
+    const unsigned char * pTelegram;
+    TelegramKind kind = parseTelegram(0, pField, pTelegram, debug);
+
+    if (kind == TELEGRAM_SCAN) {
+      iScanNumber = tp_.getScanNumber();
+      countSkippedScans(iScanNumber);
+      convertScanToPolar(
+        *pField, pTelegram, vfDistanceM, vfIntensityAU, pGeometry, bInverted);
+      stampScan(0);
+    } else {
+      decodeAuxiliary(kind, pTelegram, bInverted);
+    }
+    popTelegram();
+
+    if (kind == TELEGRAM_SCAN) {
+      popAuxiliary(iScanNumber, bInverted, debug);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//-------------------------------------------
+ScannerSickS300::TelegramKind ScannerSickS300::parseTelegram(
+  int iIndex, FieldType * & pField, const unsigned char * & pTelegram, const bool debug)
+{
+  const TelegramPos & telegram = m_Telegrams[(m_iFirstTelegram + iIndex) % MAX_PENDING_TELEGRAMS];
+  size_t iViewSize;
+  pTelegram = m_RxBuf.readView(telegram.start, iViewSize);
+
+  if (!tp_.parseFrame(pTelegram, telegram.length, debug)) {return TELEGRAM_INVALID;}
+  if (tp_.isReflectors()) {return TELEGRAM_REFLECTORS;}
+  if (tp_.isIo()) {return TELEGRAM_IO;}
+  if (tp_.getNumPoints() == 0) {return TELEGRAM_INVALID;}
+
+  // The field code selects the slot, the telegrams of the fields not set are dropped
+  int iField = tp_.getField();
+  if (iField < 1 || iField > MAX_FIELDS || !m_Fields[iField - 1].bConfigured) {
+    return TELEGRAM_INVALID;
+  }
+  pField = &m_Fields[iField - 1];
+  return TELEGRAM_SCAN;
+}
+
+//-------------------------------------------
+void ScannerSickS300::decodeAuxiliary(
+  TelegramKind kind, const unsigned char * pTelegram, const bool bInverted)
+{
+  if (kind == TELEGRAM_REFLECTORS) {
+    decodeReflectors(pTelegram, bInverted);
+  } else if (kind == TELEGRAM_IO) {
+    decodeIo(pTelegram);
+  }
+}
+
+//-------------------------------------------
+void ScannerSickS300::popAuxiliary(unsigned int iScanNumber, const bool bInverted, const bool debug)
+{
+  // The reflector and I/O telegrams sent after a scan are decoded with it
+  while (m_iNumTelegrams > 0 && m_Telegrams[m_iFirstTelegram].scan_number == iScanNumber) {
+    FieldType * pField;
+    const unsigned char * pTelegram;
+    TelegramKind kind = parseTelegram(0, pField, pTelegram, debug);
+    if (kind != TELEGRAM_REFLECTORS && kind != TELEGRAM_IO) {break;}
+
+    decodeAuxiliary(kind, pTelegram, bInverted);
+    popTelegram();
+  }
+}
+
+//-------------------------------------------
+void ScannerSickS300::decodeReflectors(const unsigned char * pTelegram, const bool bInverted)
+{
+  // Without a scan the angles of the measurements are not known
+  const FieldType * pField = getField(m_iLastField);
+  for (int i = 1; pField == nullptr && i <= MAX_FIELDS; i++) {
+    pField = getField(i);
+  }
+  if (pField == nullptr) {return;}
+  const ScanGeometry & geometry = pField->geometry;
+  const double dScale = pField->param.dScale;
+
+  const unsigned char * pData = TelegramParser::getWordData(pTelegram);
+  size_t iNumReflectors = tp_.getNumWords() / TelegramParser::REFLECTOR_WORDS;
+  if (iNumReflectors > MAX_REFLECTORS) {
+    iNumReflectors = MAX_REFLECTORS;
+  }
+
+  m_Reflectors.iScanNumber = tp_.getScanNumber();
+  m_Reflectors.vReflectors.resize(iNumReflectors);
+  size_t iNumValid = 0;
+  for (size_t i = 0; i < iNumReflectors; i++) {
+    unsigned int iWords[TelegramParser::REFLECTOR_WORDS];
+    for (int w = 0; w < TelegramParser::REFLECTOR_WORDS; w++) {
+      const unsigned char * pWord = pData + 2 * (i * TelegramParser::REFLECTOR_WORDS + w);
+      iWords[w] = pWord[0] | (static_cast<unsigned int>(pWord[1]) << 8);
+    }
+
+    // Beams out of the scan cannot be placed, and would wrap around when mirrored
+    unsigned int iLast = geometry.iNumBeams > 0 ? geometry.iNumBeams - 1 : 0;
+    if (iWords[0] > iWords[1] || iWords[1] > iLast) {continue;}
+
+    // The beams are numbered as sent, the scans may be written in reverse order
+    Reflector & reflector = m_Reflectors.vReflectors[iNumValid++];
+    reflector.iFirstBeam = bInverted ? iLast - iWords[1] : iWords[0];
+    reflector.iLastBeam = bInverted ? iLast - iWords[0] : iWords[1];
+    reflector.dAngle = geometry.dAngleMin +
+      0.5 * (reflector.iFirstBeam + reflector.iLastBeam) * geometry.dAngleIncrement;
+    reflector.dDistanceM = (iWords[2] & 0x1FFF) * dScale;
+  }
+  m_Reflectors.vReflectors.resize(iNumValid);
+  m_bNewReflectors = true;
+}
+
+//-------------------------------------------
+void ScannerSickS300::decodeIo(const unsigned char * pTelegram)
+{
+  const unsigned char * pData = TelegramParser::getWordData(pTelegram);
+  size_t iNumWords = tp_.getNumWords();
+  if (iNumWords > MAX_IO_WORDS) {
+    iNumWords = MAX_IO_WORDS;
+  }
+
+  m_Io.iScanNumber = tp_.getScanNumber();
+  m_Io.viWords.resize(iNumWords);
+  for (size_t i = 0; i < iNumWords; i++) {
+    m_Io.viWords[i] = static_cast<uint16_t>(pData[2 * i] | (pData[2 * i + 1] << 8));
+  }
+  m_bNewIo = true;
+}
+
+//-------------------------------------------
+const ScannerSickS300::ReflectorData * ScannerSickS300::takeReflectors()
+{
+  if (!m_bNewReflectors) {return nullptr;}
+  m_bNewReflectors = false;
+  return &m_Reflectors;
+}
+
+//-------------------------------------------
+const ScannerSickS300::IoData * ScannerSickS300::takeIo()
+{
+  if (!m_bNewIo) {return nullptr;}
+  m_bNewIo = false;
+  return &m_Io;
+}
+
+//-------------------------------------------
+void ScannerSickS300::countSkippedScans(unsigned int iScanNumber)
+{
+  // Several fields are sent with the same scan number, only gaps are counted
+  unsigned int iDiff = iScanNumber - m_uiLastReadScanNumber;
+  if (m_bScanNumberValid && iDiff > 1 && iDiff < c_iMaxSkippedScans) {
+    m_uiSkippedScans += iDiff - 1;
+  }
+  if (!m_bScanNumberValid || iDiff != 0) {
+    m_uiLastReadScanNumber = iScanNumber;
+    m_bScanNumberValid = true;
+  }
+}
+
+//-------------------------------------------
+int ScannerSickS300::receiveTelegrams()
+{
+  makeRoom();
+
+  // The free region may wrap around the end of the buffer, one call fills both parts
+  size_t iFree, iWrapped;
+  unsigned char * pWrapped;
+  unsigned char * pWrite = m_RxBuf.writeView(iFree, pWrapped, iWrapped);
+  ::iovec vBuffers[2];
+  vBuffers[0].iov_base = pWrite;
+  vBuffers[0].iov_len = iFree;
+  vBuffers[1].iov_base = pWrapped;
+  vBuffers[1].iov_len = iWrapped;
+  int iNumRead = m_SerialIO.readVector(vBuffers, iWrapped > 0 ? 2 : 1);
+  if (iNumRead <= 0) {
+    // The reads block until a byte arrives, so nothing read is the end of the file
+    m_bPortLost = iNumRead == 0 || (errno != EAGAIN && errno != EINTR);
+    return iNumRead;
+  }
+
+  if (m_pCapture) {
+    int64_t iNow = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+    size_t iFirst = static_cast<size_t>(iNumRead) < iFree ? iNumRead : iFree;
+    m_pCapture->writeChunk(iNow, pWrite, iFirst, pWrapped, iNumRead - iFirst);
+  }
+
+  m_RxBuf.commit(iNumRead);
+  addReadTime();
+  frameTelegrams();
+
+  return iNumRead;
+}
+
+//-------------------------------------------
+void ScannerSickS300::feed(const unsigned char * pData, size_t iSize)
+{
+  while (iSize > 0) {
+    makeRoom();
+    size_t iWritten = m_RxBuf.write(pData, iSize);
+    addReadTime();
+    frameTelegrams();
+    pData += iWritten;
+    iSize -= iWritten;
+  }
+}
+
+//-------------------------------------------
+bool ScannerSickS300::startCapture(const char * pcPath)
+{
+  std::unique_ptr<CaptureWriter> pCapture(new CaptureWriter());
+  if (!pCapture->open(pcPath, m_iBaudRate)) {return false;}
+
+  m_pCapture = std::move(pCapture);
+  m_uiCaptureStart = m_RxBuf.end();
+  return true;
+}
+
+//-------------------------------------------
+void ScannerSickS300::stopCapture()
+{
+  m_pCapture.reset();
+}
+
+//-------------------------------------------
+void ScannerSickS300::makeRoom()
+{
+  // Make room for a whole telegram, dropping the oldest complete ones first
+  while (m_RxBuf.space() < TelegramFramer::MAX_TELEGRAM_SIZE && m_iNumTelegrams > 0) {
+    popTelegram();
+    m_uiDroppedTelegrams++;
+  }
+  if (m_RxBuf.space() == 0) {
+    clearTelegrams();
+  }
+}
+
+//-------------------------------------------
+void ScannerSickS300::frameTelegrams()
+{
+  while (true) {
+    size_t iSize, iStart, iLength;
+    const unsigned char * pView = m_RxBuf.readView(m_uiFramePos, iSize);
+    bool bFound = m_Framer.next(pView, iSize, iStart, iLength);
+
+    if (bFound) {
+      if (m_iNumTelegrams == MAX_PENDING_TELEGRAMS) {
+        popTelegram();
+        m_uiDroppedTelegrams++;
+      }
+      TelegramPos & telegram =
+        m_Telegrams[(m_iFirstTelegram + m_iNumTelegrams) % MAX_PENDING_TELEGRAMS];
+      telegram.start = m_uiFramePos + iStart;
+      telegram.length = iLength;
+      // The telegrams are sent back to back, any byte in between means the sync was lost
+      if (m_uiReceivedTelegrams > 0 && telegram.start != m_uiLastTelegramEnd) {
+        m_uiResyncs++;
+      }
+      m_uiLastTelegramEnd = telegram.start + iLength;
+      // The scan number (bytes 14 to 17) is sent in network order
+      const unsigned char * pNumber = pView + iStart + 14;
+      telegram.scan_number = (static_cast<unsigned int>(pNumber[0]) << 24) |
+        (static_cast<unsigned int>(pNumber[1]) << 16) |
+        (static_cast<unsigned int>(pNumber[2]) << 8) | pNumber[3];
+      m_uiLastReceivedScanNumber = telegram.scan_number;
+      m_iNumTelegrams++;
+      m_uiReceivedTelegrams++;
+      m_uiLastTelegramLength = iLength;
+      stampTelegram(telegram);
+      if (m_pCapture && telegram.start >= m_uiCaptureStart) {
+        m_pCapture->addTelegram(
+          telegram.start - m_uiCaptureStart, static_cast<uint32_t>(iLength), telegram.scan_number);
+      }
     }
+
+    // Move the framer forward; the view is contiguous from its new position
+    size_t iDiscard = m_Framer.discardable();
+    m_Framer.consume(iDiscard);
+    m_uiFramePos += iDiscard;
+
+    if (!bFound && iDiscard == 0) {break;}
   }
 
-  return bRet;
+  if (m_iNumTelegrams == 0) {
+    m_RxBuf.release(m_uiFramePos);
+  }
+}
+
+//-------------------------------------------
+void ScannerSickS300::addReadTime()
+{
+#ifdef SICKS300_LATENCY_STATS
+  if (!m_bLatencyStats) {return;}
+
+  ReadTime & read = m_ReadTimes[m_iNextReadTime];
+  read.end = m_RxBuf.end();
+  read.time_ns = LatencyHistogram::now();
+  m_iNextReadTime = (m_iNextReadTime + 1) % MAX_READ_TIMES;
+#endif
+}
+
+//-------------------------------------------
+void ScannerSickS300::stampTelegram(TelegramPos & telegram) const
+{
+  telegram.first_byte_ns = telegram.complete_ns = telegram.crc_ok_ns = 0;
+#ifdef SICKS300_LATENCY_STATS
+  if (!m_bLatencyStats) {return;}
+
+  // The telegram is complete since the last read; its first byte came with the oldest
+  // read ending after its start
+  int iLast = (m_iNextReadTime + MAX_READ_TIMES - 1) % MAX_READ_TIMES;
+  telegram.complete_ns = m_ReadTimes[iLast].time_ns;
+  telegram.first_byte_ns = telegram.complete_ns;
+  for (int i = 1; i < MAX_READ_TIMES; i++) {
+    const ReadTime & read = m_ReadTimes[(iLast + MAX_READ_TIMES - i) % MAX_READ_TIMES];
+    if (read.time_ns == 0 || read.end <= telegram.start) {break;}
+    telegram.first_byte_ns = read.time_ns;
+  }
+  telegram.crc_ok_ns = LatencyHistogram::now();
+#endif
+}
+
+//-------------------------------------------
+void ScannerSickS300::stampScan(int iIndex)
+{
+  const TelegramPos & telegram = m_Telegrams[(m_iFirstTelegram + iIndex) % MAX_PENDING_TELEGRAMS];
+  m_ScanTimes.iFirstByteNs = telegram.first_byte_ns;
+  m_ScanTimes.iCompleteNs = telegram.complete_ns;
+  m_ScanTimes.iCrcOkNs = telegram.crc_ok_ns;
+  m_ScanTimes.iDecodedNs = 0;
+#ifdef SICKS300_LATENCY_STATS
+  if (m_bLatencyStats) {
+    m_ScanTimes.iDecodedNs = LatencyHistogram::now();
+  }
+#endif
+}
+
+//-------------------------------------------
+double ScannerSickS300::getTelegramWait() const
+{
+  if (!m_bAdaptiveReads) {return 0.0;}
+
+  size_t iBuffered = m_RxBuf.end() - m_uiFramePos;
+  size_t iMissing = m_Framer.missing(iBuffered);
+  if (iMissing == 0 && iBuffered > 0 && iBuffered < m_uiLastTelegramLength) {
+    // The header is not complete yet, the telegram is likely as long as the last one
+    iMissing = m_uiLastTelegramLength - iBuffered;
+  }
+
+  // The read has just emptied the queue of the port, so every missing byte is still to come
+  return static_cast<double>(iMissing) * m_dByteTime;
+}
+
+//-------------------------------------------
+void ScannerSickS300::popTelegram()
+{
+  m_iFirstTelegram = (m_iFirstTelegram + 1) % MAX_PENDING_TELEGRAMS;
+  m_iNumTelegrams--;
+  m_RxBuf.release(m_iNumTelegrams > 0 ? m_Telegrams[m_iFirstTelegram].start : m_uiFramePos);
+}
+
+//-------------------------------------------
+void ScannerSickS300::clearTelegrams()
+{
+  m_RxBuf.clear();
+  m_Framer.reset();
+  m_uiFramePos = m_RxBuf.end();
+  m_iFirstTelegram = 0;
+  m_iNumTelegrams = 0;
+}
+
+//-------------------------------------------
+void ScannerSickS300::setRangeField(const int field, const ParamType & param)
+{
+  if (field < 1 || field > MAX_FIELDS) {return;}
+
+  FieldType & f = m_Fields[field - 1];
+  f.bConfigured = true;
+  f.param = param;
+  computeGeometry(param, DEFAULT_NUM_BEAMS, f.geometry);
+}
+
+//-------------------------------------------
+void ScannerSickS300::clearFields()
+{
+  for (FieldType & field : m_Fields) {
+    field.bConfigured = false;
+  }
+}
+
+//-------------------------------------------
+const ScannerSickS300::ScanGeometry * ScannerSickS300::getGeometry(const int field) const
+{
+  const FieldType * pField = getField(field);
+  return pField != nullptr ? &pField->geometry : nullptr;
+}
+
+//-------------------------------------------
+const ScannerSickS300::FieldType * ScannerSickS300::getField(const int field) const
+{
+  if (field < 1 || field > MAX_FIELDS || !m_Fields[field - 1].bConfigured) {return nullptr;}
+  return &m_Fields[field - 1];
+}
+
+//-------------------------------------------
+void ScannerSickS300::computeGeometry(
+  const ParamType & param, size_t iNumBeams,
+  ScanGeometry & geometry)
+{
+  geometry.iNumBeams = iNumBeams;
+  geometry.dAngleMin = param.dStartAngle;
+  geometry.dAngleIncrement = iNumBeams > 1 ?
+    fabs(param.dStopAngle - param.dStartAngle) / static_cast<double>(iNumBeams - 1) : 0.0;
+  geometry.dAngleMax = iNumBeams > 0 ?
+    geometry.dAngleMin + (iNumBeams - 1) * geometry.dAngleIncrement : geometry.dAngleMin;
+
+  geometry.vfSin.resize(iNumBeams);
+  geometry.vfCos.resize(iNumBeams);
+  for (size_t i = 0; i < iNumBeams; i++) {
+    double dAngle = geometry.dAngleMin + i * geometry.dAngleIncrement;
+    geometry.vfSin[i] = static_cast<float>(sin(dAngle));
+    geometry.vfCos[i] = static_cast<float>(cos(dAngle));
+  }
 }
 
 //-------------------------------------------
 void ScannerSickS300::convertScanToPolar(
-  const PARAM_MAP::const_iterator param, std::vector<int> viScanRaw,
-  std::vector<ScanPolarType> & vecScanPolar)
+  FieldType & field, const unsigned char * pTelegram,
+  std::vector<float> & vfDistanceM, std::vector<float> & vfIntensityAU,
+  const ScanGeometry * & pGeometry, const bool bInverted)
 {
-  double dDist;
-  double dAngle, dAngleStep;
-  double dIntens;
+  const size_t iNumPoints = tp_.getNumPoints();
+  const unsigned char * pData = TelegramParser::getDistData(pTelegram);
+  const double dScale = field.param.dScale;
   bool bInStandby = true;
 
-  vecScanPolar.resize(viScanRaw.size());
-  dAngleStep = fabs(param->second.dStopAngle - param->second.dStartAngle) /
-    static_cast<double>(viScanRaw.size() - 1);
+  // Only a scanner configured with another resolution gets here more than once
+  ScanGeometry & geometry = field.geometry;
+  if (geometry.iNumBeams != iNumPoints) {
+    computeGeometry(field.param, iNumPoints, geometry);
+  }
+  pGeometry = &geometry;
+  m_iLastField = field.param.range_field;
 
+  // Resizing keeps the capacity, so a reused message is not reallocated
+  vfDistanceM.resize(iNumPoints);
+  vfIntensityAU.resize(iNumPoints);
+  float * pfDist = vfDistanceM.data();
+  float * pfIntens = vfIntensityAU.data();
 
-  for (size_t i = 0; i < viScanRaw.size(); i++) {
-    dDist = static_cast<double>((viScanRaw[i] & 0x1FFF) * param->second.dScale);
+  for (size_t i = 0; i < iNumPoints; i++) {
+    unsigned int iRaw = pData[2 * i] | (static_cast<unsigned int>(pData[2 * i + 1]) << 8);
 
     // if not all values are 0x4004 , we are not in standby
-    if (!(viScanRaw[i] == 0x4004) ) {
+    if (iRaw != 0x4004) {
       bInStandby = false;
     }
 
-    dAngle = param->second.dStartAngle + i * dAngleStep;
-    dIntens = static_cast<double>(viScanRaw[i] & 0x2000);
-
-    vecScanPolar[i].dr = dDist;
-    vecScanPolar[i].da = dAngle;
-    vecScanPolar[i].di = dIntens;
+    size_t j = bInverted ? iNumPoints - 1 - i : i;
+    pfDist[j] = static_cast<float>((iRaw & 0x1FFF) * dScale);
+    pfIntens[j] = static_cast<float>(iRaw & 0x2000);
   }
 
   m_bInStandby = bInStandby;
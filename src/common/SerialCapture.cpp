@@ -0,0 +1,298 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include "sicks300_ros2/common/SerialCapture.hpp"
+
+namespace
+{
+
+const char c_acCaptureMagic[8] = {'S', '3', '0', '0', 'C', 'A', 'P', '1'};
+const char c_acIndexMagic[8] = {'S', '3', '0', '0', 'I', 'D', 'X', '1'};
+const uint32_t c_uiVersion = 1;
+const uint32_t c_uiDataChunk = 1;
+
+// Records are padded to this size, so they are aligned in a mapping
+const size_t c_iAlignment = 8;
+
+// Buffer of the file, a few telegrams are written at once
+const size_t c_iFileBufferSize = 64 * 1024;
+
+struct FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  int32_t baud_rate;
+  int64_t start_ns;
+  uint64_t reserved;
+};
+
+struct ChunkHeader
+{
+  int64_t receive_ns;
+  uint32_t size;
+  uint32_t type;
+};
+
+struct Footer
+{
+  char magic[8];
+  uint64_t index_offset;
+  uint64_t num_telegrams;
+  uint64_t stream_size;
+};
+
+size_t padding(size_t size)
+{
+  return (c_iAlignment - size % c_iAlignment) % c_iAlignment;
+}
+
+int64_t wallNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+//-----------------------------------------------
+CaptureWriter::CaptureWriter()
+: file_(nullptr),
+  file_size_(0),
+  stream_size_(0)
+{
+}
+
+CaptureWriter::~CaptureWriter()
+{
+  close();
+}
+
+bool CaptureWriter::open(const char * path, int baud_rate)
+{
+  close();
+
+  file_ = fopen(path, "wb");
+  if (file_ == nullptr) {return false;}
+  setvbuf(file_, nullptr, _IOFBF, c_iFileBufferSize);
+
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, c_acCaptureMagic, sizeof(header.magic));
+  header.version = c_uiVersion;
+  header.baud_rate = baud_rate;
+  header.start_ns = wallNow();
+  fwrite(&header, sizeof(header), 1, file_);
+
+  file_size_ = sizeof(header);
+  stream_size_ = 0;
+  index_.clear();
+  return true;
+}
+
+void CaptureWriter::close()
+{
+  if (file_ == nullptr) {return;}
+
+  Footer footer;
+  memset(&footer, 0, sizeof(footer));
+  memcpy(footer.magic, c_acIndexMagic, sizeof(footer.magic));
+  footer.index_offset = file_size_;
+  footer.num_telegrams = index_.size();
+  footer.stream_size = stream_size_;
+  if (!index_.empty()) {
+    fwrite(index_.data(), sizeof(IndexEntry), index_.size(), file_);
+  }
+  fwrite(&footer, sizeof(footer), 1, file_);
+
+  fclose(file_);
+  file_ = nullptr;
+  index_.clear();
+}
+
+void CaptureWriter::writeChunk(
+  int64_t receive_ns, const unsigned char * data, size_t size,
+  const unsigned char * wrapped, size_t wrapped_size)
+{
+  if (file_ == nullptr) {return;}
+
+  ChunkHeader header;
+  header.receive_ns = receive_ns;
+  header.size = static_cast<uint32_t>(size + wrapped_size);
+  header.type = c_uiDataChunk;
+  fwrite(&header, sizeof(header), 1, file_);
+  fwrite(data, 1, size, file_);
+  if (wrapped_size > 0) {
+    fwrite(wrapped, 1, wrapped_size, file_);
+  }
+
+  const uint64_t zeros = 0;
+  size_t pad = padding(header.size);
+  fwrite(&zeros, 1, pad, file_);
+
+  file_size_ += sizeof(header) + header.size + pad;
+  stream_size_ += header.size;
+}
+
+void CaptureWriter::addTelegram(uint64_t stream_offset, uint32_t length, uint32_t scan_number)
+{
+  if (file_ == nullptr) {return;}
+
+  IndexEntry entry;
+  entry.stream_offset = stream_offset;
+  entry.length = length;
+  entry.scan_number = scan_number;
+  index_.push_back(entry);
+}
+
+//-----------------------------------------------
+CaptureReader::CaptureReader()
+: mapping_(nullptr),
+  mapping_size_(0),
+  baud_rate_(0),
+  start_ns_(0),
+  telegrams_(nullptr),
+  num_telegrams_(0)
+{
+}
+
+CaptureReader::~CaptureReader()
+{
+  close();
+}
+
+bool CaptureReader::open(const char * path)
+{
+  close();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {return false;}
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    return false;
+  }
+
+  mapping_size_ = st.st_size;
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    return false;
+  }
+
+  const unsigned char * base = static_cast<const unsigned char *>(mapping_);
+  const FileHeader * header = reinterpret_cast<const FileHeader *>(base);
+  if (memcmp(header->magic, c_acCaptureMagic, sizeof(header->magic)) != 0 ||
+    header->version != c_uiVersion)
+  {
+    close();
+    return false;
+  }
+  baud_rate_ = header->baud_rate;
+  start_ns_ = header->start_ns;
+
+  // The chunks end at the index if the capture was closed, otherwise at the end of the file
+  size_t chunks_end = mapping_size_;
+  if (mapping_size_ >= sizeof(FileHeader) + sizeof(Footer)) {
+    const Footer * footer =
+      reinterpret_cast<const Footer *>(base + mapping_size_ - sizeof(Footer));
+    if (memcmp(footer->magic, c_acIndexMagic, sizeof(footer->magic)) == 0 &&
+      footer->index_offset + footer->num_telegrams * sizeof(Telegram) + sizeof(Footer) ==
+      mapping_size_)
+    {
+      chunks_end = footer->index_offset;
+      telegrams_ = reinterpret_cast<const Telegram *>(base + footer->index_offset);
+      num_telegrams_ = footer->num_telegrams;
+    }
+  }
+
+  // Only the headers of the chunks are read, a partial record at the end is ignored
+  size_t offset = sizeof(FileHeader);
+  uint64_t stream_offset = 0;
+  while (offset + sizeof(ChunkHeader) <= chunks_end) {
+    const ChunkHeader * chunk_header = reinterpret_cast<const ChunkHeader *>(base + offset);
+    size_t data_offset = offset + sizeof(ChunkHeader);
+    if (data_offset + chunk_header->size > chunks_end) {break;}
+
+    if (chunk_header->type == c_uiDataChunk) {
+      Chunk chunk;
+      chunk.data = base + data_offset;
+      chunk.size = chunk_header->size;
+      chunk.receive_ns = chunk_header->receive_ns;
+      chunk.stream_offset = stream_offset;
+      chunks_.push_back(chunk);
+      stream_offset += chunk.size;
+    }
+    offset = data_offset + chunk_header->size + padding(chunk_header->size);
+  }
+
+  return true;
+}
+
+void CaptureReader::close()
+{
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+  }
+  mapping_size_ = 0;
+  chunks_.clear();
+  telegrams_ = nullptr;
+  num_telegrams_ = 0;
+}
+
+size_t CaptureReader::findChunk(uint64_t stream_offset) const
+{
+  // Last chunk starting at or before the offset
+  size_t first = 0, last = chunks_.size();
+  while (last - first > 1) {
+    size_t middle = (first + last) / 2;
+    if (chunks_[middle].stream_offset <= stream_offset) {
+      first = middle;
+    } else {
+      last = middle;
+    }
+  }
+  return first;
+}
+
+size_t CaptureReader::replay(
+  double speed, const ChunkCallback & on_chunk, size_t first_chunk) const
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  size_t count = 0;
+
+  for (size_t i = first_chunk; i < chunks_.size(); i++) {
+    const Chunk & chunk = chunks_[i];
+    if (speed > 0.0) {
+      double elapsed = (chunk.receive_ns - chunks_[first_chunk].receive_ns) * 1e-9 / speed;
+      std::this_thread::sleep_until(
+        start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(elapsed)));
+    }
+    count++;
+    if (!on_chunk(chunk)) {break;}
+  }
+  return count;
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// termios2 is declared by the kernel headers, which conflict with <termios.h>,
+// so it is kept apart from SerialIO.cpp.
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+
+#include "SerialCustomBaud.hpp"
+
+namespace detail
+{
+
+bool setCustomBaudrate(int iDevice, int iBaudrate)
+{
+  struct termios2 tio;
+  if (ioctl(iDevice, TCGETS2, &tio) == -1) {
+    return false;
+  }
+
+  // Exact input and output speeds instead of a divisor of the base clock
+  tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+  tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+  tio.c_ispeed = iBaudrate;
+  tio.c_ospeed = iBaudrate;
+
+  return ioctl(iDevice, TCSETS2, &tio) != -1;
+}
+
+}  // namespace detail
@@ -0,0 +1,33 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SICKS300_ROS2__COMMON__SERIALCUSTOMBAUD_HPP_
+#define SICKS300_ROS2__COMMON__SERIALCUSTOMBAUD_HPP_
+
+// Internal to SerialIO, not installed with the public headers.
+namespace detail
+{
+
+/**
+ * @brief Set a baudrate that has no termios code, with the termios2 ioctls
+ *
+ * @param iDevice File descriptor of the open port
+ * @param iBaudrate Baudrate in bits per second
+ * @return true if the port accepted it
+ */
+bool setCustomBaudrate(int iDevice, int iBaudrate);
+
+}  // namespace detail
+
+#endif  // SICKS300_ROS2__COMMON__SERIALCUSTOMBAUD_HPP_
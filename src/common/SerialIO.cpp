@@ -23,10 +23,12 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 #include <linux/serial.h>
 #include <iostream>
 
 #include "sicks300_ros2/common/SerialIO.hpp"
+#include "SerialCustomBaud.hpp"
 
 // #define _PRINT_BYTES
 
@@ -108,7 +110,10 @@ SerialIO::SerialIO()
   m_ReadBufSize(1024),
   m_WriteBufSize(m_ReadBufSize),
   m_Timeout(0),
-  m_ShortBytePeriod(false)
+  m_ShortBytePeriod(false),
+  m_LowLatency(false),
+  m_CustomBaudRate(0),
+  m_NumSyscalls(0)
 {
   m_BytePeriod.tv_sec = 0;
   m_BytePeriod.tv_usec = 0;
@@ -123,6 +128,8 @@ int SerialIO::openIO()
 {
   int Res;
 
+  m_NumSyscalls = 0;
+
   // open device
   m_Device = open(m_DeviceName.c_str(), O_RDWR | O_NOCTTY /*| O_NONBLOCK*/);
 
@@ -183,13 +190,25 @@ int SerialIO::openIO()
   cfsetispeed(&m_tio, iBaudrateCode);
   cfsetospeed(&m_tio, iBaudrateCode);
 
+  // Baudrates without code are set exactly with termios2 each time the attributes are written
+  m_CustomBaudRate = 0;
   if (!bBaudrateValid) {
     std::cout << "Baudrate code not available - setting baudrate directly" << std::endl;
+    m_CustomBaudRate = iNewBaudrate;
+  }
+
+  // Deliver the received bytes at once instead of after the latency timer of USB adapters
+  if (m_LowLatency) {
     struct serial_struct ss;
-    ioctl(m_Device, TIOCGSERIAL, &ss);
-    ss.flags |= ASYNC_SPD_CUST;
-    ss.custom_divisor = ss.baud_base / iNewBaudrate;
-    ioctl(m_Device, TIOCSSERIAL, &ss);
+    if (ioctl(m_Device, TIOCGSERIAL, &ss) == -1) {
+      std::cout << "Low latency mode not supported by " << m_DeviceName << std::endl;
+    } else {
+      ss.flags |= ASYNC_LOW_LATENCY;
+      if (ioctl(m_Device, TIOCSSERIAL, &ss) == -1) {
+        std::cout << "Setting low latency mode of " << m_DeviceName << " failed: "
+                  << strerror(errno) << " (Error code " << errno << ")" << std::endl;
+      }
+    }
   }
 
 
@@ -257,7 +276,7 @@ int SerialIO::openIO()
   m_tio.c_lflag &= ~ICANON;
 
   // write parameters
-  Res = tcsetattr(m_Device, TCSANOW, &m_tio);
+  Res = setAttributes();
 
   if (Res == -1) {
     std::cout << "tcsetattr " << m_DeviceName << " failed: "
@@ -291,8 +310,22 @@ void SerialIO::setTimeout(double Timeout)
   m_Timeout = Timeout;
   if (m_Device != -1) {
     m_tio.c_cc[VTIME] = cc_t(ceil(m_Timeout * 10.0));
-    tcsetattr(m_Device, TCSANOW, &m_tio);
+    setAttributes();
+  }
+}
+
+int SerialIO::setAttributes()
+{
+  int Res = tcsetattr(m_Device, TCSANOW, &m_tio);
+
+  // tcsetattr() overwrites the speed with the code of m_tio
+  if (Res != -1 && m_CustomBaudRate > 0 &&
+    !detail::setCustomBaudrate(m_Device, m_CustomBaudRate))
+  {
+    std::cout << "Setting baudrate " << m_CustomBaudRate << " of " << m_DeviceName
+              << " failed: " << strerror(errno) << " (Error code " << errno << ")" << std::endl;
   }
+  return Res;
 }
 
 void SerialIO::setBytePeriod(double Period)
@@ -307,6 +340,7 @@ void SerialIO::setBytePeriod(double Period)
 int SerialIO::readBlocking(char * Buffer, int Length)
 {
   ssize_t BytesRead;
+  m_NumSyscalls++;
   BytesRead = read(m_Device, Buffer, Length);
 #ifdef PRINT_BYTES
   printf("%2d Bytes read:", BytesRead);
@@ -324,6 +358,7 @@ int SerialIO::readNonBlocking(char * Buffer, int Length)
   int iBytesToRead = (Length < iAvaibleBytes) ? Length : iAvaibleBytes;
   ssize_t BytesRead;
 
+  m_NumSyscalls++;
   BytesRead = read(m_Device, Buffer, iBytesToRead);
 
   // Debug
@@ -337,6 +372,30 @@ int SerialIO::readNonBlocking(char * Buffer, int Length)
   return BytesRead;
 }
 
+int SerialIO::readVector(const ::iovec * Buffers, int Count)
+{
+  m_NumSyscalls++;
+  return readv(m_Device, Buffers, Count);
+}
+
+bool SerialIO::waitReadable(double Timeout)
+{
+  if (m_Device == -1) {
+    return false;
+  }
+
+  ::pollfd pfd;
+  pfd.fd = m_Device;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+
+  m_NumSyscalls++;
+  int Res = poll(&pfd, 1, static_cast<int>(Timeout * 1000.0));
+  // A hang up or an error is reported by the next read, otherwise the caller would wait
+  // again at once without ever blocking
+  return Res > 0 && pfd.revents != 0;
+}
+
 int SerialIO::writeIO(const char * Buffer, int Length)
 {
   ssize_t BytesWritten;
@@ -368,6 +427,7 @@ int SerialIO::writeIO(const char * Buffer, int Length)
 int SerialIO::getSizeRXQueue()
 {
   int cbInQue;
+  m_NumSyscalls++;
   int Res = ioctl(m_Device, FIONREAD, &cbInQue);
   if (Res == -1) {
     return 0;
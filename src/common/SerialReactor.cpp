@@ -0,0 +1,320 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <utility>
+
+#include "sicks300_ros2/common/RealTime.hpp"
+#include "sicks300_ros2/common/SerialReactor.hpp"
+
+namespace
+{
+
+// Longest wait of the reactor thread, which bounds the resolution of the timeouts
+const double c_dMaxWait = 0.1;
+
+const int c_iMaxEvents = 16;
+
+int64_t steadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+SerialReactor::SerialReactor()
+: running_(false),
+  thread_settings_applied_(false),
+  priority_error_(0),
+  affinity_error_(0)
+{
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  ::epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+}
+
+SerialReactor::~SerialReactor()
+{
+  stop();
+  close(wake_fd_);
+  close(epoll_fd_);
+}
+
+std::shared_ptr<SerialReactor> SerialReactor::getShared()
+{
+  static std::mutex shared_mutex;
+  static std::weak_ptr<SerialReactor> shared;
+
+  std::lock_guard<std::mutex> lock(shared_mutex);
+  std::shared_ptr<SerialReactor> reactor = shared.lock();
+  if (!reactor) {
+    reactor = std::make_shared<SerialReactor>();
+    reactor->start();
+    shared = reactor;
+  }
+  return reactor;
+}
+
+bool SerialReactor::add(
+  ScannerSickS300 & scanner, const Options & options, ScanCallback on_scan,
+  TimeoutCallback on_timeout)
+{
+  int fd = scanner.getDescriptor();
+  if (fd < 0 || epoll_fd_ < 0) {return false;}
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  registrations_.emplace_back();
+  Registration & registration = registrations_.back();
+  registration.scanner = &scanner;
+  registration.options = options;
+  registration.on_scan = std::move(on_scan);
+  registration.on_timeout = std::move(on_timeout);
+  registration.last_scan_ns = steadyNow();
+  registration.resume_ns = 0;
+  registration.active = true;
+
+  ::epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = &registration;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+    registrations_.pop_back();
+    return false;
+  }
+  return true;
+}
+
+void SerialReactor::remove(ScannerSickS300 & scanner)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = registrations_.begin(); it != registrations_.end(); ++it) {
+    if (it->scanner == &scanner) {
+      if (it->active) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, scanner.getDescriptor(), nullptr);
+      }
+      registrations_.erase(it);
+      return;
+    }
+  }
+}
+
+void SerialReactor::start()
+{
+  if (running_.exchange(true)) {return;}
+
+  thread_ = std::thread(
+    [this]() {
+      while (running_) {
+        runOnce(c_dMaxWait);
+      }
+    });
+}
+
+void SerialReactor::stop()
+{
+  running_ = false;
+  wakeUp();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool SerialReactor::applyThreadSettings(
+  const ThreadSettings & settings, int & priority_error, int & affinity_error)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!thread_settings_applied_) {
+    thread_settings_applied_ = true;
+    thread_settings_ = settings;
+    priority_error_ = 0;
+    affinity_error_ = 0;
+    if (settings.priority > 0) {
+      priority_error_ = RealTime::setPriority(thread_.native_handle(), settings.priority);
+    }
+    if (!settings.cpus.empty()) {
+      affinity_error_ = RealTime::setAffinity(thread_.native_handle(), settings.cpus);
+    }
+  } else if (!(settings == thread_settings_)) {
+    return false;
+  }
+
+  priority_error = priority_error_;
+  affinity_error = affinity_error_;
+  return true;
+}
+
+int SerialReactor::runOnce(double timeout)
+{
+  // Wake up in time to wait again for the ports left out while a telegram arrives
+  int64_t timeout_ns = static_cast<int64_t>(timeout * 1e9);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t next_resume = getNextResume();
+    if (next_resume > 0) {
+      int64_t until_resume = next_resume - steadyNow();
+      timeout_ns = until_resume < timeout_ns ? until_resume : timeout_ns;
+    }
+  }
+  int timeout_ms = timeout_ns > 0 ? static_cast<int>((timeout_ns + 999999) / 1000000) : 0;
+
+  ::epoll_event events[c_iMaxEvents];
+  int num_events = epoll_wait(epoll_fd_, events, c_iMaxEvents, timeout_ms);
+  if (num_events < 0) {
+    return errno == EINTR ? 0 : -1;
+  }
+
+  // The registrations may have changed while waiting, so the events are only trusted
+  // for the registrations still in the list
+  std::lock_guard<std::mutex> lock(mutex_);
+  resumePorts(steadyNow());
+  int serviced = 0;
+  for (int i = 0; i < num_events; i++) {
+    if (events[i].data.ptr == nullptr) {
+      uint64_t count;
+      ssize_t res = read(wake_fd_, &count, sizeof(count));
+      (void)res;
+      continue;
+    }
+
+    for (auto & registration : registrations_) {
+      if (&registration == events[i].data.ptr) {
+        if (events[i].events & EPOLLIN) {
+          service(registration);
+          serviced++;
+        } else if (registration.active) {
+          // Hang up or error without data, e.g. an unplugged adapter or a closed pty. The
+          // read returns at once and finds the port lost.
+          service(registration);
+          if (registration.active) {
+            registration.scanner->markPortLost();
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, registration.scanner->getDescriptor(), nullptr);
+            registration.active = false;
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  checkTimeouts();
+  return serviced;
+}
+
+void SerialReactor::service(Registration & registration)
+{
+  ScannerSickS300 & scanner = *registration.scanner;
+  const Options & options = registration.options;
+  Scan & scan = registration.scan;
+
+  int num_read = scanner.receiveTelegrams();
+  if (num_read <= 0) {
+    if (scanner.isPortLost()) {
+      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, scanner.getDescriptor(), nullptr);
+      registration.active = false;
+    }
+    return;
+  }
+
+  scan.newest_scan_number = scanner.getLastScanNumber();
+  if (options.all_scans) {
+    while (scanner.nextScan(
+        scan.ranges, scan.intensities, scan.geometry, scan.scan_number,
+        options.inverted, options.debug))
+    {
+      scan.in_standby = scanner.isInStandby();
+      registration.last_scan_ns = steadyNow();
+      registration.on_scan(scan);
+    }
+  } else {
+    // The newest scan of every field
+    while (scanner.lastScan(
+        scan.ranges, scan.intensities, scan.geometry, scan.scan_number,
+        options.inverted, options.debug))
+    {
+      scan.in_standby = scanner.isInStandby();
+      registration.last_scan_ns = steadyNow();
+      registration.on_scan(scan);
+    }
+  }
+
+  // Leave the port out of the wait until the rest of the telegram has arrived
+  double wait = scanner.getTelegramWait();
+  if (wait > 0.0) {
+    ::epoll_event event;
+    event.events = 0;
+    event.data.ptr = &registration;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, scanner.getDescriptor(), &event) == 0) {
+      registration.resume_ns = steadyNow() + static_cast<int64_t>(wait * 1e9);
+    }
+  }
+}
+
+void SerialReactor::resumePorts(int64_t now)
+{
+  for (auto & registration : registrations_) {
+    if (registration.resume_ns == 0 || registration.resume_ns > now) {continue;}
+
+    registration.resume_ns = 0;
+    if (registration.active) {
+      ::epoll_event event;
+      event.events = EPOLLIN;
+      event.data.ptr = &registration;
+      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, registration.scanner->getDescriptor(), &event);
+    }
+  }
+}
+
+int64_t SerialReactor::getNextResume() const
+{
+  int64_t next_resume = 0;
+  for (const auto & registration : registrations_) {
+    if (registration.resume_ns > 0 &&
+      (next_resume == 0 || registration.resume_ns < next_resume))
+    {
+      next_resume = registration.resume_ns;
+    }
+  }
+  return next_resume;
+}
+
+void SerialReactor::checkTimeouts()
+{
+  int64_t now = steadyNow();
+  for (auto & registration : registrations_) {
+    const Options & options = registration.options;
+    if (options.timeout <= 0.0 || !registration.on_timeout) {continue;}
+
+    if (now - registration.last_scan_ns > static_cast<int64_t>(options.timeout * 1e9)) {
+      // Reported again after every timeout period without scans
+      registration.last_scan_ns = now;
+      registration.on_timeout();
+    }
+  }
+}
+
+void SerialReactor::wakeUp()
+{
+  uint64_t one = 1;
+  ssize_t res = write(wake_fd_, &one, sizeof(one));
+  (void)res;
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sicks300_ros2/common/TelegramFramer.hpp"
+#include "sicks300_ros2/common/TelegramS300.hpp"
+
+namespace
+{
+// Bytes of the reply header and the block number, which are always zero
+const size_t SYNC_ZEROS = 6;
+// Offset of the coordination flag (0xFF) from the start of the telegram
+const size_t SYNC_FLAG_OFFSET = 8;
+// Offset of the device address from the start of the telegram
+const size_t DEVICE_ADDRESS_OFFSET = 9;
+// Bytes needed to read the size and the protocol version
+const size_t HEADER_SIZE = 12;
+// The first 4 bytes (reply header) are not part of the CRC
+const size_t CRC_START = 4;
+}  // namespace
+
+TelegramFramer::TelegramFramer()
+{
+  reset();
+  crc_errors_ = 0;
+  size_rule_ = -1;
+  size_rule_failures_ = 0;
+  device_address_ = ANY_ADDRESS;
+}
+
+void TelegramFramer::reset()
+{
+  state_ = SYNC;
+  pos_ = 0;
+  zero_run_ = 0;
+  start_ = 0;
+  crc_pos_ = 0;
+  crc_ = 0xFFFF;
+  lengths_[0] = lengths_[1] = 0;
+  num_lengths_ = 0;
+  length_idx_ = 0;
+  new_protocol_ = false;
+}
+
+bool TelegramFramer::next(
+  const unsigned char * buffer, size_t size, size_t & start, size_t & length)
+{
+  while (true) {
+    switch (state_) {
+      case SYNC:
+        if (!findSync(buffer, size)) {return false;}
+        break;
+      case HEADER:
+        if (!readHeader(buffer, size)) {return false;}
+        break;
+      case CRC:
+        if (checkCrc(buffer, size, length)) {
+          start = start_;
+          // Continue the search right after this telegram
+          pos_ = start_ + length;
+          zero_run_ = 0;
+          state_ = SYNC;
+          return true;
+        }
+        if (state_ == CRC) {return false;}
+        break;
+    }
+  }
+}
+
+bool TelegramFramer::findSync(const unsigned char * buffer, size_t size)
+{
+  while (pos_ < size) {
+    size_t run = buffer[pos_] == 0 ? zero_run_ + 1 : 0;
+    if (run >= SYNC_ZEROS) {
+      // The coordination flag is SYNC_FLAG_OFFSET bytes after the first zero
+      size_t flag = pos_ + 1 + SYNC_FLAG_OFFSET - SYNC_ZEROS;
+      if (flag >= size) {return false;}
+      zero_run_ = run;
+      pos_++;
+      if (buffer[flag] == 0xFF) {
+        start_ = pos_ - SYNC_ZEROS;
+        state_ = HEADER;
+        return true;
+      }
+    } else {
+      zero_run_ = run;
+      pos_++;
+    }
+  }
+  return false;
+}
+
+bool TelegramFramer::readHeader(const unsigned char * buffer, size_t size)
+{
+  if (start_ + HEADER_SIZE > size) {return false;}
+
+  const unsigned char * header = buffer + start_;
+  if (device_address_ != ANY_ADDRESS && header[DEVICE_ADDRESS_OFFSET] != device_address_) {
+    // Sent by another device, or a false sync
+    state_ = SYNC;
+    return true;
+  }
+
+  size_t words = (static_cast<size_t>(header[6]) << 8) | header[7];
+  // Read in memory order of a little endian host, so 0x102 is the bytes 02 01 on the line
+  uint16_t protocol_version = header[10] | (static_cast<uint16_t>(header[11]) << 8);
+
+  // The size is given in 16 bit words, counted from a byte that depends on the protocol
+  // and on the configuration of the scanner, see pp. 70-73 in:
+  // https://www.sick.com/media/dox/1/91/891/Telegram_listing_S3000_Expert_Anti_Collision_S300_Expert_de_en_IM0022891.PDF // NOLINT
+  if (protocol_version == 0x102) {
+    // Old protocol: counted from the 5th byte up to and including the CRC
+    lengths_[0] = 2 * words + 4;
+    num_lengths_ = 1;
+    new_protocol_ = false;
+  } else {
+    // The configuration cannot be deduced from the telegram, so both rules are checked
+    // against the CRC. No I/O or measuring field configured: counted from the 9th byte up
+    // to and including the CRC
+    lengths_[0] = 2 * words + 8;
+    // Any I/O or measuring field configured: counted from the 13th byte up to the CRC
+    lengths_[1] = 2 * words + 14;
+    num_lengths_ = 2;
+    new_protocol_ = true;
+  }
+
+  // Once a telegram was found only the rule it used is checked
+  length_idx_ = 0;
+  if (new_protocol_ && size_rule_ >= 0) {
+    length_idx_ = size_rule_;
+    num_lengths_ = size_rule_ + 1;
+  }
+
+  // A short I/O telegram may be too small for the shorter rule only
+  while (length_idx_ < num_lengths_ && lengths_[length_idx_] < MIN_TELEGRAM_SIZE) {
+    length_idx_++;
+  }
+
+  if (length_idx_ == num_lengths_ || lengths_[num_lengths_ - 1] > MAX_TELEGRAM_SIZE) {
+    // Not a telegram, keep searching after the false sync
+    state_ = SYNC;
+    return true;
+  }
+
+  crc_ = 0xFFFF;
+  crc_pos_ = start_ + CRC_START;
+  state_ = CRC;
+  return true;
+}
+
+bool TelegramFramer::checkCrc(const unsigned char * buffer, size_t size, size_t & length)
+{
+  while (length_idx_ < num_lengths_) {
+    size_t telegram_end = start_ + lengths_[length_idx_];
+    size_t crc_end = telegram_end - sizeof(uint16_t);
+
+    // Carry the CRC over whatever has been received so far
+    size_t available = (size < crc_end ? size : crc_end);
+    if (available > crc_pos_) {
+      crc_ = TelegramParser::updateCRC(crc_, buffer + crc_pos_, available - crc_pos_);
+      crc_pos_ = available;
+    }
+    if (telegram_end > size) {return false;}
+
+    // The CRC is transmitted in little endian
+    uint16_t received = buffer[crc_end] | (static_cast<uint16_t>(buffer[crc_end + 1]) << 8);
+    if (received == crc_) {
+      length = lengths_[length_idx_];
+      if (new_protocol_) {
+        size_rule_ = length_idx_;
+        size_rule_failures_ = 0;
+      }
+      return true;
+    }
+
+    // Try the longer telegram, its CRC continues where this one stopped
+    length_idx_++;
+  }
+
+  // Not a valid telegram, resume the search after the false sync. The scanner may have
+  // been configured again, so both rules are checked after too many failures in a row.
+  crc_errors_++;
+  if (new_protocol_ && size_rule_ >= 0 && ++size_rule_failures_ >= MAX_SIZE_RULE_FAILURES) {
+    size_rule_ = -1;
+    size_rule_failures_ = 0;
+  }
+  state_ = SYNC;
+  return false;
+}
+
+void TelegramFramer::consume(size_t count)
+{
+  pos_ -= count;
+  start_ = start_ >= count ? start_ - count : 0;
+  crc_pos_ = crc_pos_ >= count ? crc_pos_ - count : 0;
+}
+
+size_t TelegramFramer::discardable() const
+{
+  if (state_ == SYNC) {
+    // The search has already checked every candidate starting before the last zeros
+    return pos_ - (zero_run_ < SYNC_ZEROS ? zero_run_ : SYNC_ZEROS - 1);
+  }
+  return start_;
+}
+
+size_t TelegramFramer::missing(size_t size) const
+{
+  if (state_ != CRC) {return 0;}
+  size_t telegram_end = start_ + lengths_[length_idx_];
+  return telegram_end > size ? telegram_end - size : 0;
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <string.h>
+
+#include "sicks300_ros2/common/Crc16.hpp"
+#include "sicks300_ros2/common/TelegramGenerator.hpp"
+
+namespace
+{
+
+void putBigEndian16(unsigned char * data, unsigned int value)
+{
+  data[0] = static_cast<unsigned char>(value >> 8);
+  data[1] = static_cast<unsigned char>(value);
+}
+
+void putLittleEndian16(unsigned char * data, unsigned int value)
+{
+  data[0] = static_cast<unsigned char>(value);
+  data[1] = static_cast<unsigned char>(value >> 8);
+}
+
+}  // namespace
+
+TelegramGenerator::TelegramGenerator(const Options & options)
+: options_(options),
+  scan_number_(options.first_scan_number),
+  telegram_number_(0),
+  standby_(false)
+{
+  // The header only changes in the scan and telegram numbers
+  telegram_.assign(HEADER_SIZE + 2 * options_.num_beams + CRC_SIZE, 0);
+  putHeader(telegram_, 0xBBBB);
+  putBigEndian16(&telegram_[22], 0x1111 * options_.field);
+}
+
+void TelegramGenerator::putHeader(std::vector<unsigned char> & telegram, unsigned int type) const
+{
+  size_t size = telegram.size();
+  size_t words;
+  switch (options_.protocol) {
+    case PROTOCOL_0102:
+      words = (size - 4) / 2;
+      break;
+    case PROTOCOL_0301_FIELDS:
+      words = (size - 12 - CRC_SIZE) / 2;
+      break;
+    case PROTOCOL_0301:
+    default:
+      words = (size - 8) / 2;
+      break;
+  }
+  putBigEndian16(&telegram[6], static_cast<unsigned int>(words));
+  telegram[8] = 0xFF;
+  telegram[9] = options_.device_address;
+  telegram[10] = options_.protocol == PROTOCOL_0102 ? 0x02 : 0x03;
+  telegram[11] = 0x01;
+  putBigEndian16(&telegram[20], type);
+}
+
+void TelegramGenerator::finish(std::vector<unsigned char> & telegram, unsigned int scan_number)
+{
+  unsigned char * data = telegram.data();
+  putBigEndian16(&data[14], scan_number >> 16);
+  putBigEndian16(&data[16], scan_number & 0xFFFF);
+  putBigEndian16(&data[18], telegram_number_);
+  telegram_number_++;
+
+  // The reply header is not part of the CRC, which is sent in little endian
+  size_t crc_end = telegram.size() - CRC_SIZE;
+  putLittleEndian16(data + crc_end, Crc16::update(0xFFFF, data + 4, crc_end - 4));
+}
+
+const std::vector<unsigned char> & TelegramGenerator::next()
+{
+  unsigned char * measurements = telegram_.data() + HEADER_SIZE;
+  double phase = 0.01 * scan_number_;
+  for (size_t i = 0; i < options_.num_beams; i++) {
+    unsigned int value = STANDBY_VALUE;
+    if (!standby_) {
+      // Distance in cm to the walls of a room between 1 and 4 meters
+      double angle = static_cast<double>(i) / options_.num_beams * 2.0 * M_PI;
+      value = static_cast<unsigned int>(250.0 + 150.0 * sin(3.0 * angle + phase));
+      if (i % REFLECTOR_SPACING == 0) {
+        value |= REFLECTOR_BIT;
+      }
+    }
+    putLittleEndian16(measurements + 2 * i, value);
+  }
+
+  finish(telegram_, scan_number_);
+  scan_number_++;
+  return telegram_;
+}
+
+const std::vector<unsigned char> & TelegramGenerator::nextReflectors()
+{
+  // First beam, last beam and distance of every measurement marked as a reflector
+  const unsigned char * measurements = telegram_.data() + HEADER_SIZE;
+  std::vector<uint16_t> words;
+  for (size_t i = 0; i < options_.num_beams; i++) {
+    unsigned int value = measurements[2 * i] | (measurements[2 * i + 1] << 8);
+    if (value != STANDBY_VALUE && (value & REFLECTOR_BIT)) {
+      words.push_back(static_cast<uint16_t>(i));
+      words.push_back(static_cast<uint16_t>(i));
+      words.push_back(static_cast<uint16_t>(value & 0x1FFF));
+    }
+  }
+  return nextWords(words, 0xCCCC);
+}
+
+const std::vector<unsigned char> & TelegramGenerator::nextReflectors(
+  const std::vector<uint16_t> & words)
+{
+  return nextWords(words, 0xCCCC);
+}
+
+const std::vector<unsigned char> & TelegramGenerator::nextIo(const std::vector<uint16_t> & words)
+{
+  return nextWords(words, 0xAAAA);
+}
+
+const std::vector<unsigned char> & TelegramGenerator::nextWords(
+  const std::vector<uint16_t> & words, unsigned int type)
+{
+  auxiliary_.assign(TYPE_END + 2 * words.size() + CRC_SIZE, 0);
+  putHeader(auxiliary_, type);
+  for (size_t i = 0; i < words.size(); i++) {
+    putLittleEndian16(&auxiliary_[TYPE_END + 2 * i], words[i]);
+  }
+  finish(auxiliary_, scan_number_ - 1);
+  return auxiliary_;
+}
+
+bool TelegramGenerator::parseProtocol(const char * name, Protocol & protocol)
+{
+  if (strcmp(name, "0102") == 0) {
+    protocol = PROTOCOL_0102;
+  } else if (strcmp(name, "0301") == 0) {
+    protocol = PROTOCOL_0301;
+  } else if (strcmp(name, "0301-fields") == 0) {
+    protocol = PROTOCOL_0301_FIELDS;
+  } else {
+    return false;
+  }
+  return true;
+}
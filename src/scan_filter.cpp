@@ -12,140 +12,160 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// C++
+#include <cmath>
+#include <utility>
+#include <vector>
+
 // ROS includes
-#include "rclcpp/rclcpp.hpp"
 #include "rclcpp/qos.hpp"
-#include "sensor_msgs/msg/laser_scan.hpp"
+#include "sicks300_ros2/scan_filter.hpp"
 
-class ScanFilter : public rclcpp::Node
+namespace sicks300_ros2
 {
-public:
-  ScanFilter()
-  : Node("scan_filter")
-  {
-    declare_parameter_if_not_declared(
-      this, "lower_angle",
-      rclcpp::ParameterValue(0.0), rcl_interfaces::msg::ParameterDescriptor()
-      .set__description("The angle of the scan to begin filtering at"));
-    this->get_parameter("lower_angle", lower_angle_);
-    RCLCPP_INFO(
-      this->get_logger(),
-      "The parameter lower_angle is set to: %f", lower_angle_);
 
-    declare_parameter_if_not_declared(
-      this, "upper_angle",
-      rclcpp::ParameterValue(0.0), rcl_interfaces::msg::ParameterDescriptor()
-      .set__description("The angle of the scan to end filtering at"));
-    this->get_parameter("upper_angle", upper_angle_);
+ScanFilter::ScanFilter(const rclcpp::NodeOptions & options)
+: Node("scan_filter", options)
+{
+  window_.valid = false;
+
+  declare_parameter_if_not_declared(
+    this, "lower_angle",
+    rclcpp::ParameterValue(0.0), rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("The angle of the scan to begin filtering at"));
+  this->get_parameter("lower_angle", lower_angle_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter lower_angle is set to: %f", lower_angle_);
+
+  declare_parameter_if_not_declared(
+    this, "upper_angle",
+    rclcpp::ParameterValue(0.0), rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("The angle of the scan to end filtering at"));
+  this->get_parameter("upper_angle", upper_angle_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter upper_angle is set to: %f", upper_angle_);
+
+  parameters_handle_ = this->add_on_set_parameters_callback(
+    std::bind(&ScanFilter::parameters_callback, this, std::placeholders::_1));
+
+  // Create publisher and subscriber
+  laser_scan_sub_ = this->create_subscription<sensor_msgs::msg::LaserScan>(
+    "scan", rclcpp::SensorDataQoS(),
+    std::bind(&ScanFilter::scan_callback, this, std::placeholders::_1));
+  laser_scan_filtered_pub_ = this->create_publisher<sensor_msgs::msg::LaserScan>(
+    "scan_filtered", rclcpp::SystemDefaultsQoS());
+}
+
+rcl_interfaces::msg::SetParametersResult ScanFilter::parameters_callback(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto & parameter : parameters) {
+    if (parameter.get_name() == "lower_angle") {
+      lower_angle_ = parameter.as_double();
+    } else if (parameter.get_name() == "upper_angle") {
+      upper_angle_ = parameter.as_double();
+    } else {
+      continue;
+    }
     RCLCPP_INFO(
       this->get_logger(),
-      "The parameter upper_angle is set to: %f", upper_angle_);
+      "The parameter %s is set to: %f", parameter.get_name().c_str(), parameter.as_double());
+    window_.valid = false;
+  }
 
+  return result;
+}
 
-    // Create publisher and subscriber
-    laser_scan_sub_ = this->create_subscription<sensor_msgs::msg::LaserScan>(
-      "scan", rclcpp::SensorDataQoS(),
-      std::bind(&ScanFilter::scan_callback, this, std::placeholders::_1));
-    laser_scan_filtered_pub_ = this->create_publisher<sensor_msgs::msg::LaserScan>(
-      "scan_filtered", rclcpp::SystemDefaultsQoS());
+void ScanFilter::update_window(const sensor_msgs::msg::LaserScan & msg)
+{
+  window_.valid = true;
+  window_.angle_min = msg.angle_min;
+  window_.angle_increment = msg.angle_increment;
+  window_.size = msg.ranges.size();
+  compute_window(
+    lower_angle_, upper_angle_, msg.angle_min, msg.angle_increment, window_.size,
+    window_.first, window_.count);
+}
+
+void ScanFilter::compute_window(
+  double lower_angle, double upper_angle, float angle_min, float angle_increment,
+  size_t size, size_t & first, size_t & count)
+{
+  // Tolerance in beams, so an angle on a bound is not lost to rounding
+  const double epsilon = 1e-4;
+
+  if (angle_increment <= 0.0f) {
+    first = 0;
+    count = size;
+    return;
   }
 
-private:
-  /**
-   * @brief Declares static ROS2 parameter and sets it to a given value if it was not already declared.
-   *
-   * @param node A node in which given parameter to be declared
-   * @param param_name The name of parameter
-   * @param default_value Parameter value to initialize with
-   * @param parameter_descriptor Parameter descriptor (optional)
-  */
-  template<typename NodeT>
-  void declare_parameter_if_not_declared(
-    NodeT node,
-    const std::string & param_name,
-    const rclcpp::ParameterValue & default_value,
-    const rcl_interfaces::msg::ParameterDescriptor & parameter_descriptor =
-    rcl_interfaces::msg::ParameterDescriptor())
-  {
-    if (!node->has_parameter(param_name)) {
-      node->declare_parameter(param_name, default_value, parameter_descriptor);
-    }
+  // The first beam at or after the lower bound is kept, and then every beam up to the
+  // upper bound, but at least one
+  double first_beam = std::ceil((lower_angle - angle_min) / angle_increment - epsilon);
+  double last_beam = std::floor((upper_angle - angle_min) / angle_increment + epsilon);
+  first = first_beam > 0.0 ? static_cast<size_t>(first_beam) : 0;
+  if (first >= size) {
+    first = size;
+    count = 0;
+    return;
+  }
+  size_t last = last_beam > 0.0 ? static_cast<size_t>(last_beam) : 0;
+  if (last < first) {
+    last = first;
+  } else if (last >= size) {
+    last = size - 1;
   }
+  count = last - first + 1;
+}
 
-  void scan_callback(const sensor_msgs::msg::LaserScan & msg)
+void ScanFilter::scan_callback(sensor_msgs::msg::LaserScan::UniquePtr msg)
+{
+  size_t first, count;
   {
-    // Create new message
-    auto msg_filtered = sensor_msgs::msg::LaserScan();
-    msg_filtered.ranges.resize(msg.ranges.size());
-    msg_filtered.intensities.resize(msg.intensities.size());
-
-    double start_angle = msg.angle_min;
-    double current_angle = msg.angle_min;
-    builtin_interfaces::msg::Time start_time = msg.header.stamp;
-    unsigned int count = 0;
-
-    // Loop through the scan and truncate the beginning and the end of the scan as necessary
-    for (unsigned int i = 0; i < msg.ranges.size(); ++i) {
-      // Wait until we get to our desired starting angle
-      if (start_angle < lower_angle_) {
-        start_angle += msg.angle_increment;
-        current_angle += msg.angle_increment;
-        // start_time.set__sec(start_time.sec + msg.time_increment);
-      } else {
-        msg_filtered.ranges[count] = msg.ranges[i];
-
-        // Make sure  that we don't update intensity data if its not available
-        if (msg.intensities.size() > i) {
-          msg_filtered.intensities[count] = msg.intensities[i];
-        }
-        count++;
-
-        // Check if we need to break out of the loop,
-        // basically if the next increment will put us over the threshold
-        if (current_angle + msg.angle_increment > upper_angle_) {
-          break;
-        }
-
-        current_angle += msg.angle_increment;
-      }
-    }
-
-    // Make sure to set all the needed fields on the filtered scan
-    msg_filtered.header.frame_id = msg.header.frame_id;
-    msg_filtered.header.stamp = start_time;
-    msg_filtered.angle_min = start_angle;
-    msg_filtered.angle_max = current_angle;
-    msg_filtered.angle_increment = msg.angle_increment;
-    msg_filtered.time_increment = msg.time_increment;
-    msg_filtered.scan_time = msg.scan_time;
-    msg_filtered.range_min = msg.range_min;
-    msg_filtered.range_max = msg.range_max;
-
-    msg_filtered.ranges.resize(count);
-
-    if (msg.intensities.size() >= count) {
-      msg_filtered.intensities.resize(count);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!window_.valid || window_.angle_min != msg->angle_min ||
+      window_.angle_increment != msg->angle_increment || window_.size != msg->ranges.size())
+    {
+      update_window(*msg);
     }
-
-    // Publish message
-    laser_scan_filtered_pub_->publish(msg_filtered);
+    first = window_.first;
+    count = window_.count;
   }
 
-  rclcpp::Subscription<sensor_msgs::msg::LaserScan>::SharedPtr laser_scan_sub_;
-  rclcpp::Publisher<sensor_msgs::msg::LaserScan>::SharedPtr laser_scan_filtered_pub_;
+  crop_scan(*msg, first, count);
 
-  float lower_angle_, upper_angle_;
-};
+  // Publish the same message
+  laser_scan_filtered_pub_->publish(std::move(msg));
+}
 
-/* Main */
-int main(int argc, char ** argv)
+void ScanFilter::crop_scan(sensor_msgs::msg::LaserScan & msg, size_t first, size_t count)
 {
-  rclcpp::init(argc, argv);
-
-  rclcpp::executors::SingleThreadedExecutor exe;
-  auto node = std::make_shared<ScanFilter>();
-  exe.add_node(node->get_node_base_interface());
-  exe.spin();
-  rclcpp::shutdown();
-  return 0;
+  // Crop the arrays in place, shrinking them keeps their buffers
+  msg.ranges.erase(msg.ranges.begin(), msg.ranges.begin() + first);
+  msg.ranges.resize(count);
+
+  // The intensities are optional, those that do not match the ranges are dropped
+  if (msg.intensities.size() >= first + count) {
+    msg.intensities.erase(msg.intensities.begin(), msg.intensities.begin() + first);
+    msg.intensities.resize(count);
+  } else {
+    msg.intensities.clear();
+  }
+
+  // Make sure to set all the needed fields on the filtered scan
+  const double angle_min = msg.angle_min;
+  msg.angle_min = angle_min + first * msg.angle_increment;
+  msg.angle_max = angle_min + (first + (count > 0 ? count - 1 : 0)) * msg.angle_increment;
 }
+
+}  // namespace sicks300_ros2
+
+#include "rclcpp_components/register_node_macro.hpp"
+RCLCPP_COMPONENTS_REGISTER_NODE(sicks300_ros2::ScanFilter)
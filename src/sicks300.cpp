@@ -13,11 +13,17 @@
 // limitations under the License.
 
 // C++
+#include <string.h>
+
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 // ROS
+#include "lifecycle_msgs/msg/state.hpp"
 #include "rclcpp/qos.hpp"
+#include "sicks300_ros2/common/RealTime.hpp"
+#include "sicks300_ros2/common/ScanPoints.hpp"
 #include "sicks300_ros2/sicks300.hpp"
 
 using namespace std::chrono_literals;
@@ -25,16 +31,65 @@ using namespace std::chrono_literals;
 namespace sicks300_ros2
 {
 
+namespace
+{
+
+// Stack touched by the thread that locks the memory
+const size_t c_iPrefaultStackSize = 512 * 1024;
+
+// Valid ranges of the measurements. Though the specs state otherwise, the max range reported
+// by the scanner is 29.96m
+const float c_fRangeMin = 0.001f;
+const float c_fRangeMax = 29.5f;
+
+// Result of a setting of the operating system, reported in the diagnostics
+std::string describeSetting(int error)
+{
+  return error == 0 ? "applied" : std::string("failed: ") + strerror(error);
+}
+
+}  // namespace
+
 SickS300::SickS300(const rclcpp::NodeOptions & options)
 : rclcpp_lifecycle::LifecycleNode("sicks300", "", options),
-  synced_time_ready_(false),
-  synced_sick_stamp_(0),
-  synced_ros_time_(this->now())
+  reader_running_(false),
+  port_lost_(false),
+  autostart_(false),
+  latency_stats_(false),
+  lock_memory_(false),
+  publish_laser_scan_(true),
+  publish_point_cloud_(false),
+  realtime_priority_(0),
+  priority_status_("disabled"),
+  affinity_status_("disabled"),
+  memory_status_("disabled"),
+  standby_published_(false),
+  last_communication_time_(this->now())
 {
+  resetScanMessage();
+
+  declare_parameter_if_not_declared(
+    this, "autostart", rclcpp::ParameterValue(false),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("Configure and activate the node on startup"));
+  this->get_parameter("autostart", autostart_);
+
+  // Launch cannot change the state of a node loaded in a component container,
+  // so the transitions are triggered once the node is spinning
+  if (autostart_) {
+    autostart_timer_ = this->create_wall_timer(
+      0s, [this]() {
+        autostart_timer_->cancel();
+        if (this->configure().id() == lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE) {
+          this->activate();
+        }
+      });
+  }
 }
 
 SickS300::~SickS300()
 {
+  stopReader();
   if (timer_) {
     timer_->cancel();
     timer_.reset();
@@ -105,6 +160,7 @@ CallbackReturn SickS300::on_configure(const rclcpp_lifecycle::State &)
   RCLCPP_INFO(
     this->get_logger(),
     "The parameter scan_cycle_time is set to: %f", scan_cycle_time_);
+  scan_clock_.setNominalPeriod(scan_cycle_time_);
 
   declare_parameter_if_not_declared(
     this, "scan_delay", rclcpp::ParameterValue(0.075),
@@ -115,6 +171,161 @@ CallbackReturn SickS300::on_configure(const rclcpp_lifecycle::State &)
     this->get_logger(),
     "The parameter scan_delay is set to: %f", scan_delay_);
 
+  declare_parameter_if_not_declared(
+    this, "acquisition_mode", rclcpp::ParameterValue("timer"),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description(
+      "How the serial port is read: 'timer' polls it every scan_cycle_time, "
+      "'thread' reads it from a dedicated thread as soon as bytes arrive, "
+      "'reactor' reads it from a thread shared by every scanner of the process"));
+  this->get_parameter("acquisition_mode", acquisition_mode_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter acquisition_mode is set to: %s", acquisition_mode_.c_str());
+  if (acquisition_mode_ != "timer" && acquisition_mode_ != "thread" &&
+    acquisition_mode_ != "reactor")
+  {
+    RCLCPP_ERROR(
+      this->get_logger(),
+      "Unknown acquisition_mode '%s'. Use 'timer', 'thread' or 'reactor'.",
+      acquisition_mode_.c_str());
+    return CallbackReturn::FAILURE;
+  }
+
+  declare_parameter_if_not_declared(
+    this, "publish_all_scans", rclcpp::ParameterValue(false),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description(
+      "Publish every scan received in arrival order instead of only the newest one"));
+  this->get_parameter("publish_all_scans", publish_all_scans_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter publish_all_scans is set to: %s", publish_all_scans_ ? "true" : "false");
+
+  declare_parameter_if_not_declared(
+    this, "publish_laser_scan", rclcpp::ParameterValue(true),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("Publish the scans as laser scans"));
+  this->get_parameter("publish_laser_scan", publish_laser_scan_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter publish_laser_scan is set to: %s", publish_laser_scan_ ? "true" : "false");
+
+  declare_parameter_if_not_declared(
+    this, "publish_point_cloud", rclcpp::ParameterValue(false),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("Publish the scans as point clouds, without the invalid measurements"));
+  this->get_parameter("publish_point_cloud", publish_point_cloud_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter publish_point_cloud is set to: %s", publish_point_cloud_ ? "true" : "false");
+  if (!publish_laser_scan_ && !publish_point_cloud_) {
+    RCLCPP_WARN(this->get_logger(), "Neither the laser scans nor the point clouds are published");
+  }
+
+  declare_parameter_if_not_declared(
+    this, "low_latency", rclcpp::ParameterValue(true),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description(
+      "Set the low latency mode of the serial port, so USB adapters deliver the bytes at once"));
+  this->get_parameter("low_latency", low_latency_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter low_latency is set to: %s", low_latency_ ? "true" : "false");
+  scanner_.setLowLatency(low_latency_);
+
+  declare_parameter_if_not_declared(
+    this, "adaptive_reads", rclcpp::ParameterValue(true),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description(
+      "Wait for the rest of a telegram before reading the serial port again"));
+  this->get_parameter("adaptive_reads", adaptive_reads_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter adaptive_reads is set to: %s", adaptive_reads_ ? "true" : "false");
+  scanner_.setAdaptiveReads(adaptive_reads_);
+
+  declare_parameter_if_not_declared(
+    this, "capture_file", rclcpp::ParameterValue(""),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("File to record every byte received from the scanner, empty to disable"));
+  this->get_parameter("capture_file", capture_file_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter capture_file is set to: %s", capture_file_.c_str());
+
+  declare_parameter_if_not_declared(
+    this, "latency_stats", rclcpp::ParameterValue(false),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description(
+      "Measure the latency of the stages of every scan and publish its percentiles"));
+  this->get_parameter("latency_stats", latency_stats_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter latency_stats is set to: %s", latency_stats_ ? "true" : "false");
+#ifndef SICKS300_LATENCY_STATS
+  if (latency_stats_) {
+    RCLCPP_WARN(this->get_logger(), "The latency stats were not built, they are disabled");
+    latency_stats_ = false;
+  }
+#endif
+  scanner_.setLatencyStats(latency_stats_);
+
+  declare_parameter_if_not_declared(
+    this, "latency_stats_period", rclcpp::ParameterValue(1.0),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("Period in seconds of the publication of the latency stats"));
+  this->get_parameter("latency_stats_period", latency_stats_period_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter latency_stats_period is set to: %f", latency_stats_period_);
+
+  declare_parameter_if_not_declared(
+    this, "diagnostics_period", rclcpp::ParameterValue(1.0),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("Period in seconds over which the diagnostics are aggregated"));
+  this->get_parameter("diagnostics_period", diagnostics_period_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter diagnostics_period is set to: %f", diagnostics_period_);
+
+  declare_parameter_if_not_declared(
+    this, "realtime_priority", rclcpp::ParameterValue(0),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description(
+      "SCHED_FIFO priority (1 to 99) of the thread reading the scanner, 0 to disable"));
+  this->get_parameter("realtime_priority", realtime_priority_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter realtime_priority is set to: %d", realtime_priority_);
+
+  declare_parameter_if_not_declared(
+    this, "cpu_affinity", rclcpp::ParameterValue(std::vector<int64_t>{}),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("CPUs the thread reading the scanner runs on, empty for any"));
+  this->get_parameter("cpu_affinity", cpu_affinity_);
+  std::string cpus;
+  for (int64_t cpu : cpu_affinity_) {
+    cpus += (cpus.empty() ? "" : ", ") + std::to_string(cpu);
+  }
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter cpu_affinity is set to: [%s]", cpus.c_str());
+
+  declare_parameter_if_not_declared(
+    this, "lock_memory", rclcpp::ParameterValue(false),
+    rcl_interfaces::msg::ParameterDescriptor()
+    .set__description("Lock the memory of the process so the reader never waits for a page"));
+  this->get_parameter("lock_memory", lock_memory_);
+  RCLCPP_INFO(
+    this->get_logger(),
+    "The parameter lock_memory is set to: %s", lock_memory_ ? "true" : "false");
+  if (acquisition_mode_ == "timer" && (realtime_priority_ > 0 || !cpu_affinity_.empty())) {
+    RCLCPP_WARN(
+      this->get_logger(),
+      "realtime_priority and cpu_affinity only apply to the 'thread' and 'reactor' modes");
+  }
+
   declare_parameter_if_not_declared(
     this, "debug", rclcpp::ParameterValue(false),
     rcl_interfaces::msg::ParameterDescriptor()
@@ -135,42 +346,91 @@ CallbackReturn SickS300::on_configure(const rclcpp_lifecycle::State &)
 
   // Read 'fields' params. Set 1 by default to be backwards compatible
   // TODO(ajtudela): Change this when ROS will support YAML mixed types
-  ScannerSickS300::ParamType param;
-  param.range_field = 1;
   declare_parameter_if_not_declared(
-    this, "fields.1.scale", rclcpp::ParameterValue(0.01),
+    this, "active_fields", rclcpp::ParameterValue(std::vector<int64_t>{1}),
     rcl_interfaces::msg::ParameterDescriptor()
-    .set__description("Scale of the field"));
-  this->get_parameter("fields.1.scale", param.dScale);
-  RCLCPP_INFO(this->get_logger(), "The parameter field.1.scale is set to: %f", param.dScale);
+    .set__description("Measurement fields (1 to 5) configured in the scanner"));
+  std::vector<int64_t> active_fields;
+  this->get_parameter("active_fields", active_fields);
 
-  declare_parameter_if_not_declared(
-    this, "fields.1.start_angle", rclcpp::ParameterValue(-135.0 / 180.0 * M_PI),
-    rcl_interfaces::msg::ParameterDescriptor()
-    .set__description("Start angle of the field"));
-  this->get_parameter("fields.1.start_angle", param.dStartAngle);
-  RCLCPP_INFO(
-    this->get_logger(),
-    "The parameter field.1.start_angle is set to: %f", param.dStartAngle);
+  // The fields of a previous configuration are dropped
+  scanner_.clearFields();
+  int first_field = 0;
+  for (int64_t field : active_fields) {
+    if (field < 1 || field > ScannerSickS300::MAX_FIELDS) {
+      RCLCPP_WARN(
+        this->get_logger(), "Ignoring the field %d, out of 1 to 5", static_cast<int>(field));
+      continue;
+    }
+    const std::string prefix = "fields." + std::to_string(field);
 
-  declare_parameter_if_not_declared(
-    this, "fields.1.stop_angle", rclcpp::ParameterValue(135.0 / 180.0 * M_PI),
-    rcl_interfaces::msg::ParameterDescriptor()
-    .set__description("Stop angle of the field"));
-  this->get_parameter("fields.1.stop_angle", param.dStopAngle);
-  RCLCPP_INFO(
-    this->get_logger(),
-    "The parameter field.1.stop_angle is set to: %f", param.dStopAngle);
-  scanner_.setRangeField(1, param);
+    ScannerSickS300::ParamType param;
+    param.range_field = static_cast<int>(field);
+    declare_parameter_if_not_declared(
+      this, prefix + ".scale", rclcpp::ParameterValue(0.01),
+      rcl_interfaces::msg::ParameterDescriptor()
+      .set__description("Scale of the field"));
+    this->get_parameter(prefix + ".scale", param.dScale);
+    RCLCPP_INFO(
+      this->get_logger(), "The parameter %s.scale is set to: %f", prefix.c_str(), param.dScale);
+
+    declare_parameter_if_not_declared(
+      this, prefix + ".start_angle", rclcpp::ParameterValue(-135.0 / 180.0 * M_PI),
+      rcl_interfaces::msg::ParameterDescriptor()
+      .set__description("Start angle of the field"));
+    this->get_parameter(prefix + ".start_angle", param.dStartAngle);
+    RCLCPP_INFO(
+      this->get_logger(),
+      "The parameter %s.start_angle is set to: %f", prefix.c_str(), param.dStartAngle);
+
+    declare_parameter_if_not_declared(
+      this, prefix + ".stop_angle", rclcpp::ParameterValue(135.0 / 180.0 * M_PI),
+      rcl_interfaces::msg::ParameterDescriptor()
+      .set__description("Stop angle of the field"));
+    this->get_parameter(prefix + ".stop_angle", param.dStopAngle);
+    RCLCPP_INFO(
+      this->get_logger(),
+      "The parameter %s.stop_angle is set to: %f", prefix.c_str(), param.dStopAngle);
+    scanner_.setRangeField(param.range_field, param);
+
+    // The first field keeps the scan topic, the others get their own one
+    if (laser_scan_pubs_[field - 1] || point_cloud_pubs_[field - 1]) {
+      continue;
+    }
+    std::string topic = scan_topic_;
+    if (first_field == 0) {
+      first_field = static_cast<int>(field);
+    } else {
+      topic += "/field" + std::to_string(field);
+    }
+    if (publish_laser_scan_) {
+      laser_scan_pubs_[field - 1] = this->create_publisher<sensor_msgs::msg::LaserScan>(
+        topic, rclcpp::SystemDefaultsQoS());
+    }
+    if (publish_point_cloud_) {
+      point_cloud_pubs_[field - 1] = this->create_publisher<sensor_msgs::msg::PointCloud2>(
+        topic + "/points", rclcpp::SystemDefaultsQoS());
+    }
+  }
+  if (first_field == 0) {
+    RCLCPP_ERROR(this->get_logger(), "No valid field in active_fields");
+    return CallbackReturn::FAILURE;
+  }
 
   // Configure the publishers
   auto latched_profile = rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable();
-  laser_scan_pub_ = this->create_publisher<sensor_msgs::msg::LaserScan>(
-    scan_topic_, rclcpp::SystemDefaultsQoS());
   in_standby_pub_ = this->create_publisher<std_msgs::msg::Bool>(
     scan_topic_ + "/standby", latched_profile);
   diag_pub_ = this->create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
     "/diagnostics", rclcpp::QoS(1));
+  latency_pub_ = this->create_publisher<diagnostic_msgs::msg::DiagnosticStatus>(
+    scan_topic_ + "/latency", rclcpp::QoS(1));
+  reflectors_pub_ = this->create_publisher<geometry_msgs::msg::PoseArray>(
+    scan_topic_ + "/reflectors", rclcpp::SystemDefaultsQoS());
+  io_pub_ = this->create_publisher<std_msgs::msg::UInt16MultiArray>(
+    scan_topic_ + "/io", rclcpp::SystemDefaultsQoS());
+
+  resetPointCloudMessage();
 
   // Open the laser scanner
   bool bOpenScan = this->open();
@@ -180,6 +440,21 @@ CallbackReturn SickS300::on_configure(const rclcpp_lifecycle::State &)
       "...scanner not available on port %s. Please, try again.", port_.c_str());
     return CallbackReturn::FAILURE;
   } else {
+    if (!capture_file_.empty()) {
+      if (scanner_.startCapture(capture_file_.c_str())) {
+        RCLCPP_INFO(this->get_logger(), "Recording the scanner to %s", capture_file_.c_str());
+      } else {
+        RCLCPP_ERROR(this->get_logger(), "Cannot create the capture %s", capture_file_.c_str());
+      }
+    }
+
+    // The buffers are allocated once the port is open
+    memory_status_ = "disabled";
+    if (lock_memory_) {
+      memory_status_ = describeSetting(RealTime::lockMemory(c_iPrefaultStackSize));
+      RCLCPP_INFO(this->get_logger(), "Locking the memory: %s", memory_status_.c_str());
+    }
+
     // Wait for scan to get ready if successful
     std::this_thread::sleep_for(std::chrono::milliseconds(1000));
     RCLCPP_INFO(
@@ -195,22 +470,62 @@ CallbackReturn SickS300::on_activate(const rclcpp_lifecycle::State & state)
   LifecycleNode::on_activate(state);
   RCLCPP_INFO(this->get_logger(), "Activating the node...");
 
-  timer_ = this->create_wall_timer(
-    std::chrono::duration<double>(scan_cycle_time_),
-    std::bind(&SickS300::receiveScan, this));
+  // The arrival times of the scans buffered while inactive are meaningless
+  scan_clock_.reset();
+  last_communication_time_ = this->now();
+
+  // The reader is not running yet. The counters of the scanner go on between
+  // activations, so the first window starts from their current values.
+  standby_published_ = false;
+  diag_totals_ = DiagnosticTotals();
+  readScannerTotals(diag_totals_);
+  last_diag_totals_ = diag_totals_;
+  last_diag_time_ = this->now();
+  diag_timer_ = this->create_wall_timer(
+    std::chrono::duration<double>(diagnostics_period_),
+    std::bind(&SickS300::publishDiagnostics, this));
+
+  if (latency_stats_) {
+    // Start with the scans of this activation only
+    for (auto & histogram : latency_) {
+      histogram.collect();
+    }
+    latency_timer_ = this->create_wall_timer(
+      std::chrono::duration<double>(latency_stats_period_),
+      std::bind(&SickS300::publishLatency, this));
+  }
+
+  if (acquisition_mode_ == "thread" || acquisition_mode_ == "reactor") {
+    startReader();
+  } else {
+    timer_ = this->create_wall_timer(
+      std::chrono::duration<double>(scan_cycle_time_),
+      std::bind(&SickS300::receiveScan, this));
+  }
 
   return CallbackReturn::SUCCESS;
 }
 
 CallbackReturn SickS300::on_deactivate(const rclcpp_lifecycle::State & state)
 {
-  LifecycleNode::on_deactivate(state);
   RCLCPP_INFO(this->get_logger(), "Deactivating the node...");
 
+  // Stop reading before the publishers are deactivated
+  stopReader();
+  LifecycleNode::on_deactivate(state);
+
   if (timer_) {
     timer_->cancel();
     timer_.reset();
   }
+  if (latency_timer_) {
+    latency_timer_->cancel();
+    latency_timer_.reset();
+  }
+  if (diag_timer_) {
+    diag_timer_->cancel();
+    diag_timer_.reset();
+  }
 
   return CallbackReturn::SUCCESS;
 }
@@ -219,11 +534,24 @@ CallbackReturn SickS300::on_cleanup(const rclcpp_lifecycle::State &)
 {
   RCLCPP_INFO(this->get_logger(), "Cleaning the node...");
 
+  stopReader();
+  scanner_.stopCapture();
+
   // Release the shared pointers
-  laser_scan_pub_.reset();
+  for (auto & publisher : laser_scan_pubs_) {
+    publisher.reset();
+  }
+  for (auto & publisher : point_cloud_pubs_) {
+    publisher.reset();
+  }
   in_standby_pub_.reset();
   diag_pub_.reset();
+  latency_pub_.reset();
+  reflectors_pub_.reset();
+  io_pub_.reset();
   timer_.reset();
+  latency_timer_.reset();
+  diag_timer_.reset();
 
   return CallbackReturn::SUCCESS;
 }
@@ -232,48 +560,75 @@ CallbackReturn SickS300::on_shutdown(const rclcpp_lifecycle::State & state)
 {
   RCLCPP_INFO(this->get_logger(), "Shutdown the node from state %s.", state.label().c_str());
 
+  stopReader();
+  scanner_.stopCapture();
+
   // Release the shared pointers
-  laser_scan_pub_.reset();
+  for (auto & publisher : laser_scan_pubs_) {
+    publisher.reset();
+  }
+  for (auto & publisher : point_cloud_pubs_) {
+    publisher.reset();
+  }
   in_standby_pub_.reset();
   diag_pub_.reset();
+  latency_pub_.reset();
+  reflectors_pub_.reset();
+  io_pub_.reset();
   timer_.reset();
+  latency_timer_.reset();
+  diag_timer_.reset();
 
   return CallbackReturn::SUCCESS;
 }
 
 bool SickS300::open()
 {
+  port_lost_ = false;
   return scanner_.open(port_.c_str(), baud_, scan_id_);
 }
 
 bool SickS300::receiveScan()
 {
-  std::vector<double> ranges, rangeAngles, intensities;
+  const ScannerSickS300::ScanGeometry * geometry;
   unsigned int iSickTimeStamp, iSickNow;
+  bool result = false;
 
-  int result = scanner_.getScan(
-    ranges, rangeAngles, intensities,
-    iSickTimeStamp, iSickNow, debug_);
-  static rclcpp::Time pointTimeCommunicationOK(this->now());
-
-  if (result) {
-    if (scanner_.isInStandby()) {
-      publishWarn("scanner in standby");
-      RCLCPP_WARN_THROTTLE(
-        this->get_logger(),
-        *this->get_clock(), 30, "scanner on port %s in standby", port_.c_str());
-      publishStandby(true);
-    } else {
-      publishStandby(false);
-      publishLaserScan(ranges, rangeAngles, intensities, iSickTimeStamp, iSickNow);
+  // The measurements are decoded straight into the message to be published
+  if (publish_all_scans_) {
+    if (scanner_.receiveTelegrams() > 0) {
+      // Every scan is stamped relative to the newest telegram received
+      iSickNow = scanner_.getLastScanNumber();
+      scan_clock_.update(iSickNow, this->now().nanoseconds());
+      while (scanner_.nextScan(
+          laser_scan_->ranges, laser_scan_->intensities, geometry,
+          iSickTimeStamp, inverted_, debug_))
+      {
+        handleScan(*geometry, iSickTimeStamp);
+        result = true;
+      }
     }
-
-    pointTimeCommunicationOK = this->now();
+  } else if (scanner_.receiveTelegrams() > 0) {
+    // The newest scan of every field
+    iSickNow = scanner_.getLastScanNumber();
+    scan_clock_.update(iSickNow, this->now().nanoseconds());
+    while (scanner_.lastScan(
+        laser_scan_->ranges, laser_scan_->intensities, geometry,
+        iSickTimeStamp, inverted_, debug_))
+    {
+      handleScan(*geometry, iSickTimeStamp);
+      result = true;
+    }
+  }
+  if (result) {
+    last_communication_time_ = this->now();
+  } else if (checkPortLost()) {
+    return false;
   } else {
-    rclcpp::Duration diff(this->now() - pointTimeCommunicationOK);
+    rclcpp::Duration diff(this->now() - last_communication_time_);
 
     if (diff.seconds() > communication_timeout_) {
-      RCLCPP_WARN(this->get_logger(), "Communication timeout");
+      communicationTimeout();
       return false;
     }
   }
@@ -281,60 +636,201 @@ bool SickS300::receiveScan()
   return true;
 }
 
+void SickS300::handleScan(
+  const ScannerSickS300::ScanGeometry & geometry, unsigned int iSickTimeStamp)
+{
+  updateDiagnostics(scanner_.isInStandby());
+
+  if (scanner_.isInStandby()) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(),
+      *this->get_clock(), 30, "scanner on port %s in standby", port_.c_str());
+    publishStandby(true);
+  } else {
+    publishStandby(false);
+    // The laser scan may be moved to the subscriptions, so the points are published first
+    if (publish_point_cloud_) {
+      publishPointCloud(geometry, iSickTimeStamp);
+    }
+    if (publish_laser_scan_) {
+      publishLaserScan(geometry, iSickTimeStamp);
+    }
+    if (latency_stats_) {
+      recordLatency();
+    }
+  }
+
+  publishAuxiliary();
+}
+
+void SickS300::startReader()
+{
+  stopReader();
+
+  if (acquisition_mode_ == "reactor") {
+    SerialReactor::Options options;
+    options.inverted = inverted_;
+    options.all_scans = publish_all_scans_;
+    options.timeout = communication_timeout_;
+    options.debug = debug_;
+
+    reactor_ = SerialReactor::getShared();
+    bool added = reactor_->add(
+      scanner_, options, std::bind(&SickS300::reactorScan, this, std::placeholders::_1),
+      std::bind(&SickS300::communicationTimeout, this));
+    if (!added) {
+      RCLCPP_ERROR(this->get_logger(), "The serial port cannot be added to the reactor");
+      reactor_.reset();
+      return;
+    }
+
+    // The reactor thread is shared, so it keeps the settings of the first scanner
+    SerialReactor::ThreadSettings settings;
+    settings.priority = realtime_priority_;
+    settings.cpus.assign(cpu_affinity_.begin(), cpu_affinity_.end());
+    int priority_error, affinity_error;
+    if (!reactor_->applyThreadSettings(settings, priority_error, affinity_error)) {
+      RCLCPP_ERROR(
+        this->get_logger(), "The reactor thread is shared with another scanner and runs "
+        "with a different realtime_priority or cpu_affinity, which are kept");
+      std::lock_guard<std::mutex> lock(diag_mutex_);
+      priority_status_ = affinity_status_ = "mismatch with the reactor thread";
+      return;
+    }
+    reportThreadSettings(priority_error, affinity_error);
+    return;
+  }
+
+  reader_running_ = true;
+  reader_thread_ = std::thread(&SickS300::readerLoop, this);
+  int priority_error = 0, affinity_error = 0;
+  if (realtime_priority_ > 0) {
+    priority_error = RealTime::setPriority(reader_thread_.native_handle(), realtime_priority_);
+  }
+  if (!cpu_affinity_.empty()) {
+    std::vector<int> cpus(cpu_affinity_.begin(), cpu_affinity_.end());
+    affinity_error = RealTime::setAffinity(reader_thread_.native_handle(), cpus);
+  }
+  reportThreadSettings(priority_error, affinity_error);
+}
+
+void SickS300::reportThreadSettings(int priority_error, int affinity_error)
+{
+  std::string priority_status = "disabled", affinity_status = "disabled";
+  if (realtime_priority_ > 0) {
+    priority_status = describeSetting(priority_error);
+    RCLCPP_INFO(
+      this->get_logger(), "Setting the reader priority to SCHED_FIFO %d: %s",
+      realtime_priority_, priority_status.c_str());
+  }
+  if (!cpu_affinity_.empty()) {
+    affinity_status = describeSetting(affinity_error);
+    RCLCPP_INFO(
+      this->get_logger(), "Pinning the reader to its CPUs: %s", affinity_status.c_str());
+  }
+
+  std::lock_guard<std::mutex> lock(diag_mutex_);
+  priority_status_ = priority_status;
+  affinity_status_ = affinity_status;
+}
+
+void SickS300::stopReader()
+{
+  if (reactor_) {
+    reactor_->remove(scanner_);
+    reactor_.reset();
+  }
+
+  reader_running_ = false;
+  if (reader_thread_.joinable()) {
+    reader_thread_.join();
+  }
+}
+
+void SickS300::reactorScan(SerialReactor::Scan & scan)
+{
+  scan_clock_.update(scan.newest_scan_number, this->now().nanoseconds());
+  last_communication_time_ = this->now();
+
+  // The arrays are exchanged, so the reactor decodes the next scan into the old ones
+  laser_scan_->ranges.swap(scan.ranges);
+  laser_scan_->intensities.swap(scan.intensities);
+  handleScan(*scan.geometry, scan.scan_number);
+}
+
+void SickS300::readerLoop()
+{
+  RCLCPP_INFO(this->get_logger(), "Serial reader thread started");
+
+  while (reader_running_ && rclcpp::ok()) {
+    // Wake up at least every communication_timeout to notice a deactivation
+    if (scanner_.waitForData(communication_timeout_)) {
+      receiveScan();
+      // The port only becomes readable again once the node is configured
+      if (port_lost_) {break;}
+      // Let the rest of the telegram arrive, so the next read returns it at once
+      double wait = scanner_.getTelegramWait();
+      if (wait > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+      }
+    } else if (reader_running_) {
+      communicationTimeout();
+    }
+  }
+
+  RCLCPP_INFO(this->get_logger(), "Serial reader thread stopped");
+}
+
+bool SickS300::checkPortLost()
+{
+  if (!scanner_.isPortLost()) {return false;}
+
+  if (!port_lost_.exchange(true)) {
+    RCLCPP_ERROR(
+      this->get_logger(),
+      "The serial port %s was closed or hung up, configure the node again to reopen it",
+      port_.c_str());
+  }
+  return true;
+}
+
+void SickS300::communicationTimeout()
+{
+  // The reactor stops reading a lost port and only reports the timeouts
+  if (checkPortLost()) {return;}
+  RCLCPP_WARN(this->get_logger(), "Communication timeout");
+}
+
 void SickS300::publishStandby(bool in_standby)
 {
+  if (standby_published_ && in_standby_.data == in_standby) {return;}
+
   in_standby_.data = in_standby;
   in_standby_pub_->publish(in_standby_);
+  standby_published_ = true;
 }
 
 void SickS300::publishLaserScan(
-  std::vector<double> vdDistM, std::vector<double> vdAngRAD,
-  std::vector<double> vdIntensAU, unsigned int iSickTimeStamp, unsigned int iSickNow)
+  const ScannerSickS300::ScanGeometry & geometry, unsigned int iSickTimeStamp)
 {
-  // Fill message
-  int start_scan = 0;
-  int num_readings = vdDistM.size();       // initialize with max scan size
-  int stop_scan = vdDistM.size();
-
-  // Sync handling: find out exact scan time by using the syncTime-syncStamp pair:
-  // Timestamp: "This counter is internally incremented at each scan, i.e. every 40 ms (S300)"
-  if (iSickNow != 0) {
-    synced_ros_time_ = this->now() - rclcpp::Duration::from_seconds(scan_cycle_time_);
-    synced_sick_stamp_ = iSickNow;
-    synced_time_ready_ = true;
-
-    RCLCPP_DEBUG(this->get_logger(), "Got iSickNow, store sync-stamp: %d", synced_sick_stamp_);
-  } else {
-    synced_time_ready_ = false;
-  }
-
-  // Create LaserScan message
-  sensor_msgs::msg::LaserScan laserScan;
-  if (synced_time_ready_) {
-    double timeDiff = static_cast<int>(iSickTimeStamp - synced_sick_stamp_) * scan_cycle_time_;
-    laserScan.header.stamp = synced_ros_time_ + rclcpp::Duration::from_seconds(timeDiff);
-
-    RCLCPP_DEBUG(
-      this->get_logger(), "Time::now() - calculated sick time stamp = %f",
-      (this->now() - laserScan.header.stamp).seconds());
-  } else {
-    laserScan.header.stamp = this->now();
+  sensor_msgs::msg::LaserScan & laserScan = *laser_scan_;
+  int field = scanner_.getLastField();
+  if (field < 1 || field > ScannerSickS300::MAX_FIELDS || !laser_scan_pubs_[field - 1]) {
+    return;
   }
+  auto & publisher = laser_scan_pubs_[field - 1];
+  size_t num_readings = geometry.iNumBeams;
+  laserScan.header.stamp = getScanStamp(iSickTimeStamp);
 
   // Fill message
   laserScan.header.frame_id = frame_id_;
-  laserScan.angle_increment = vdAngRAD[start_scan + 1] - vdAngRAD[start_scan];
-  laserScan.range_min = 0.001;
-  // Though the specs state otherwise, the max range reported by the scanner is 29.96m
-  laserScan.range_max = 29.5;
-  laserScan.time_increment = (scan_duration_) / (vdDistM.size());
-
-  // Rescale scan
-  num_readings = vdDistM.size();
-  laserScan.angle_min = vdAngRAD[start_scan];       // first ScanAngle
-  laserScan.angle_max = vdAngRAD[stop_scan - 1];       // last ScanAngle
-  laserScan.ranges.resize(num_readings);
-  laserScan.intensities.resize(num_readings);
+  laserScan.angle_increment = geometry.dAngleIncrement;
+  laserScan.range_min = c_fRangeMin;
+  laserScan.range_max = c_fRangeMax;
+  laserScan.time_increment = (scan_duration_) / (num_readings);
+
+  laserScan.angle_min = geometry.dAngleMin;       // first ScanAngle
+  laserScan.angle_max = geometry.dAngleMax;       // last ScanAngle
 
   // Check for inverted laser
   if (inverted_) {
@@ -344,56 +840,278 @@ void SickS300::publishLaserScan(
     // Adding of the sum over all negative increments would be mathematically correct,
     // but looks worse.
     laserScan.time_increment = -laserScan.time_increment;
+  }
+
+  // Publish Laserscan-message, the ranges and intensities were already decoded in place.
+  // Within a component container with intra-process communication enabled the message
+  // is moved to the subscriptions of the same process without serializing it.
+  if (this->get_node_options().use_intra_process_comms()) {
+    publisher->publish(std::move(laser_scan_));
+    resetScanMessage();
+  } else {
+    publisher->publish(laserScan);
+  }
+}
+
+void SickS300::publishPointCloud(
+  const ScannerSickS300::ScanGeometry & geometry, unsigned int iSickTimeStamp)
+{
+  int field = scanner_.getLastField();
+  if (field < 1 || field > ScannerSickS300::MAX_FIELDS || !point_cloud_pubs_[field - 1]) {
+    return;
+  }
+  auto & publisher = point_cloud_pubs_[field - 1];
+  const sensor_msgs::msg::LaserScan & laserScan = *laser_scan_;
+  sensor_msgs::msg::PointCloud2 & pointCloud = *point_cloud_;
+  size_t num_readings = std::min(laserScan.ranges.size(), geometry.vfSin.size());
+
+  // Sized for every measurement, then shrunk to the valid ones without freeing the memory
+  pointCloud.data.resize(num_readings * pointCloud.point_step);
+  size_t num_points = ScanPoints::convert(
+    laserScan.ranges.data(), laserScan.intensities.data(), geometry.vfSin.data(),
+    geometry.vfCos.data(), num_readings, c_fRangeMin, c_fRangeMax,
+    reinterpret_cast<float *>(pointCloud.data.data()));
+  pointCloud.data.resize(num_points * pointCloud.point_step);
+
+  pointCloud.header.stamp = getScanStamp(iSickTimeStamp);
+  pointCloud.header.frame_id = frame_id_;
+  pointCloud.width = num_points;
+  pointCloud.row_step = num_points * pointCloud.point_step;
+
+  // Handed over to the intra-process subscriptions without a copy, like the scans
+  if (this->get_node_options().use_intra_process_comms()) {
+    publisher->publish(std::move(point_cloud_));
+    resetPointCloudMessage();
   } else {
-    // to be consistent with the omission of the addition above
-    laserScan.header.stamp = rclcpp::Time(laserScan.header.stamp) -
-      rclcpp::Duration::from_seconds(scan_duration_) -
+    publisher->publish(pointCloud);
+  }
+}
+
+rclcpp::Time SickS300::getScanStamp(unsigned int iSickTimeStamp)
+{
+  // Sync handling: the scan number is incremented by the scanner at each scan, i.e. every
+  // 40 ms (S300). A model of the scanner clock fitted on the arrival times maps it to host
+  // time without the scheduling noise of the reader.
+  rclcpp::Time stamp;
+  if (scan_clock_.isReady()) {
+    stamp = rclcpp::Time(
+      scan_clock_.toTime(iSickTimeStamp), this->get_clock()->get_clock_type());
+
+    RCLCPP_DEBUG(
+      this->get_logger(), "Time::now() - calculated sick time stamp = %f",
+      (this->now() - stamp).seconds());
+  } else {
+    stamp = this->now();
+  }
+
+  if (!inverted_) {
+    // to be consistent with the omission of the addition for the inverted scanner,
+    // see publishLaserScan
+    stamp = stamp - rclcpp::Duration::from_seconds(scan_duration_) -
       rclcpp::Duration::from_seconds(scan_delay_);
   }
+  return stamp;
+}
 
-  for (int i = 0; i < (stop_scan - start_scan); i++) {
-    if (inverted_) {
-      laserScan.ranges[i] = vdDistM[stop_scan - 1 - i];
-      laserScan.intensities[i] = vdIntensAU[stop_scan - 1 - i];
-    } else {
-      laserScan.ranges[i] = vdDistM[start_scan + i];
-      laserScan.intensities[i] = vdIntensAU[start_scan + i];
+void SickS300::publishAuxiliary()
+{
+  const ScannerSickS300::ReflectorData * reflectors = scanner_.takeReflectors();
+  if (reflectors) {
+    // The message is reused, so the poses are only reallocated when there are more
+    reflectors_msg_.header.stamp = getScanStamp(reflectors->iScanNumber);
+    reflectors_msg_.header.frame_id = frame_id_;
+    reflectors_msg_.poses.resize(reflectors->vReflectors.size());
+    for (size_t i = 0; i < reflectors->vReflectors.size(); i++) {
+      const ScannerSickS300::Reflector & reflector = reflectors->vReflectors[i];
+      geometry_msgs::msg::Pose & pose = reflectors_msg_.poses[i];
+      pose.position.x = reflector.dDistanceM * cos(reflector.dAngle);
+      pose.position.y = reflector.dDistanceM * sin(reflector.dAngle);
+      pose.position.z = 0.0;
+      // Facing the scanner
+      pose.orientation.x = 0.0;
+      pose.orientation.y = 0.0;
+      pose.orientation.z = sin(0.5 * (reflector.dAngle + M_PI));
+      pose.orientation.w = cos(0.5 * (reflector.dAngle + M_PI));
     }
+    reflectors_pub_->publish(reflectors_msg_);
   }
 
-  // Publish Laserscan-message
-  laser_scan_pub_->publish(laserScan);
+  const ScannerSickS300::IoData * io = scanner_.takeIo();
+  if (io) {
+    io_msg_.data.assign(io->viWords.begin(), io->viWords.end());
+    io_pub_->publish(io_msg_);
+  }
+}
 
-  // Diagnostics
-  diagnostic_msgs::msg::DiagnosticArray diagnostics;
-  diagnostics.header.stamp = this->now();
-  diagnostics.status.resize(1);
-  diagnostics.status[0].level = diagnostic_msgs::msg::DiagnosticStatus::OK;
-  diagnostics.status[0].name = this->get_namespace();
-  diagnostics.status[0].message = "sick scanner running";
-  diag_pub_->publish(diagnostics);
+void SickS300::updateDiagnostics(bool in_standby)
+{
+  std::lock_guard<std::mutex> lock(diag_mutex_);
+  diag_totals_.scans++;
+  if (in_standby) {
+    diag_totals_.standby_scans++;
+  }
+  diag_totals_.in_standby = in_standby;
+  readScannerTotals(diag_totals_);
 }
 
-void SickS300::publishError(std::string error)
+void SickS300::readScannerTotals(DiagnosticTotals & totals) const
 {
-  diagnostic_msgs::msg::DiagnosticArray diagnostics;
-  diagnostics.header.stamp = this->now();
-  diagnostics.status.resize(1);
-  diagnostics.status[0].level = diagnostic_msgs::msg::DiagnosticStatus::ERROR;
-  diagnostics.status[0].name = this->get_namespace();
-  diagnostics.status[0].message = error;
-  diag_pub_->publish(diagnostics);
+  totals.skipped_scans = scanner_.getSkippedScans();
+  totals.dropped_telegrams = scanner_.getDroppedTelegrams();
+  totals.crc_errors = scanner_.getCrcErrors();
+  totals.resyncs = scanner_.getResyncs();
+  totals.telegrams = scanner_.getReceivedTelegrams();
+  totals.syscalls = scanner_.getNumSyscalls();
+  totals.clock_rejected = scan_clock_.getRejected();
+  totals.clock_jitter = scan_clock_.getJitter();
 }
 
-void SickS300::publishWarn(std::string warn)
+void SickS300::publishDiagnostics()
 {
+  DiagnosticTotals totals;
+  {
+    std::lock_guard<std::mutex> lock(diag_mutex_);
+    totals = diag_totals_;
+  }
+  const DiagnosticTotals & last = last_diag_totals_;
+  rclcpp::Time now = this->now();
+  double window = (now - last_diag_time_).seconds();
+
+  unsigned int scans = totals.scans - last.scans;
+  unsigned int standby_scans = totals.standby_scans - last.standby_scans;
+  unsigned int skipped_scans = totals.skipped_scans - last.skipped_scans;
+  unsigned int dropped_telegrams = totals.dropped_telegrams - last.dropped_telegrams;
+  unsigned int crc_errors = totals.crc_errors - last.crc_errors;
+  unsigned int resyncs = totals.resyncs - last.resyncs;
+  unsigned int telegrams = totals.telegrams - last.telegrams;
+  unsigned int syscalls = totals.syscalls - last.syscalls;
+
   diagnostic_msgs::msg::DiagnosticArray diagnostics;
-  diagnostics.header.stamp = this->now();
+  diagnostics.header.stamp = now;
   diagnostics.status.resize(1);
-  diagnostics.status[0].level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
-  diagnostics.status[0].name = this->get_namespace();
-  diagnostics.status[0].message = warn;
+  diagnostic_msgs::msg::DiagnosticStatus & status = diagnostics.status[0];
+  status.name = this->get_fully_qualified_name();
+  if (port_lost_) {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::ERROR;
+    status.message = "serial port lost";
+  } else if (scans == 0) {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::ERROR;
+    status.message = "no scans received";
+  } else if (totals.in_standby) {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    status.message = "scanner in standby";
+  } else if (skipped_scans + dropped_telegrams + crc_errors > 0) {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    status.message = "scans lost";
+  } else {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.message = "sick scanner running";
+  }
+
+  status.values.resize(12);
+  status.values[0].key = "scan_rate";
+  status.values[0].value = std::to_string(window > 0.0 ? scans / window : 0.0);
+  status.values[1].key = "dropped_scans";
+  status.values[1].value = std::to_string(skipped_scans);
+  status.values[2].key = "dropped_telegrams";
+  status.values[2].value = std::to_string(dropped_telegrams);
+  status.values[3].key = "crc_errors";
+  status.values[3].value = std::to_string(crc_errors);
+  status.values[4].key = "resyncs";
+  status.values[4].value = std::to_string(resyncs);
+  // Every scan received stands for the same share of the window
+  status.values[5].key = "standby_time";
+  status.values[5].value = std::to_string(
+    scans > 0 ? window * standby_scans / scans : 0.0);
+  status.values[6].key = "syscalls_per_scan";
+  status.values[6].value = std::to_string(
+    telegrams > 0 ? static_cast<double>(syscalls) / telegrams : 0.0);
+  status.values[7].key = "clock_jitter";
+  status.values[7].value = std::to_string(totals.clock_jitter);
+  status.values[8].key = "clock_rejected_samples";
+  status.values[8].value = std::to_string(totals.clock_rejected);
+  {
+    std::lock_guard<std::mutex> lock(diag_mutex_);
+    status.values[9].key = "realtime_priority";
+    status.values[9].value = priority_status_;
+    status.values[10].key = "cpu_affinity";
+    status.values[10].value = affinity_status_;
+  }
+  status.values[11].key = "lock_memory";
+  status.values[11].value = memory_status_;
   diag_pub_->publish(diagnostics);
+
+  last_diag_totals_ = totals;
+  last_diag_time_ = now;
+}
+
+void SickS300::recordLatency()
+{
+  const ScannerSickS300::ScanTimes & times = scanner_.getScanTimes();
+  if (times.iFirstByteNs == 0) {return;}
+
+  int64_t published_ns = LatencyHistogram::now();
+  latency_[LATENCY_TRANSFER].record(times.iCompleteNs - times.iFirstByteNs);
+  latency_[LATENCY_FRAMING].record(times.iCrcOkNs - times.iCompleteNs);
+  latency_[LATENCY_DECODE].record(times.iDecodedNs - times.iCrcOkNs);
+  latency_[LATENCY_PUBLISH].record(published_ns - times.iDecodedNs);
+  latency_[LATENCY_TOTAL].record(published_ns - times.iFirstByteNs);
+}
+
+void SickS300::publishLatency()
+{
+  static const char * const names[NUM_LATENCY_STAGES] = {
+    "transfer", "framing", "decode", "publish", "total"};
+
+  // The histograms are filled by the reader while they are collected, without locking
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = this->get_fully_qualified_name();
+  status.message = "scan latency in microseconds";
+  status.values.reserve(4 * NUM_LATENCY_STAGES);
+  for (int i = 0; i < NUM_LATENCY_STAGES; i++) {
+    LatencyHistogram::Summary summary = latency_[i].collect();
+    diagnostic_msgs::msg::KeyValue value;
+    value.key = std::string(names[i]) + "_count";
+    value.value = std::to_string(summary.count);
+    status.values.push_back(value);
+    value.key = std::string(names[i]) + "_p50_us";
+    value.value = std::to_string(summary.p50 * 1e-3);
+    status.values.push_back(value);
+    value.key = std::string(names[i]) + "_p99_us";
+    value.value = std::to_string(summary.p99 * 1e-3);
+    status.values.push_back(value);
+    value.key = std::string(names[i]) + "_max_us";
+    value.value = std::to_string(summary.max * 1e-3);
+    status.values.push_back(value);
+  }
+  latency_pub_->publish(status);
+}
+
+void SickS300::resetScanMessage()
+{
+  laser_scan_ = std::make_unique<sensor_msgs::msg::LaserScan>();
+  laser_scan_->ranges.reserve(ScannerSickS300::DEFAULT_NUM_BEAMS);
+  laser_scan_->intensities.reserve(ScannerSickS300::DEFAULT_NUM_BEAMS);
+}
+
+void SickS300::resetPointCloudMessage()
+{
+  // Points of x, y, z and intensity, as written by ScanPoints
+  point_cloud_ = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  point_cloud_->height = 1;
+  point_cloud_->is_bigendian = false;
+  point_cloud_->is_dense = true;
+  point_cloud_->point_step = ScanPoints::POINT_FIELDS * sizeof(float);
+  point_cloud_->fields.resize(ScanPoints::POINT_FIELDS);
+  const char * field_names[ScanPoints::POINT_FIELDS] = {"x", "y", "z", "intensity"};
+  for (size_t i = 0; i < ScanPoints::POINT_FIELDS; i++) {
+    point_cloud_->fields[i].name = field_names[i];
+    point_cloud_->fields[i].offset = i * sizeof(float);
+    point_cloud_->fields[i].datatype = sensor_msgs::msg::PointField::FLOAT32;
+    point_cloud_->fields[i].count = 1;
+  }
+  point_cloud_->data.reserve(ScannerSickS300::DEFAULT_NUM_BEAMS * point_cloud_->point_step);
 }
 
 }  // namespace sicks300_ros2
@@ -0,0 +1,70 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/Crc16.hpp"
+
+TEST(Crc16Test, BytewiseMatchesCheckValue)
+{
+  // Check value of CRC-16/CCITT-FALSE
+  const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  EXPECT_EQ(Crc16::update(Crc16::BYTEWISE, 0xFFFF, data, sizeof(data)), 0x29B1);
+  EXPECT_EQ(Crc16::update(Crc16::BYTEWISE, 0xFFFF, data, 0), 0xFFFF);
+}
+
+TEST(Crc16Test, EnginesMatchBytewise)
+{
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> data(3000);
+  for (uint8_t & value : data) {
+    value = static_cast<uint8_t>(byte(random));
+  }
+
+  for (int engine = 0; engine < Crc16::NUM_ENGINES; engine++) {
+    Crc16::Engine crc_engine = static_cast<Crc16::Engine>(engine);
+    if (!Crc16::isSupported(crc_engine)) {continue;}
+    SCOPED_TRACE(Crc16::getName(crc_engine));
+
+    // Every length up to several blocks of each engine, from unaligned starts
+    for (size_t offset = 0; offset < 8; offset++) {
+      for (size_t size = 0; size <= 300; size++) {
+        uint16_t expected = Crc16::update(Crc16::BYTEWISE, 0xFFFF, data.data() + offset, size);
+        ASSERT_EQ(
+          Crc16::update(crc_engine, 0xFFFF, data.data() + offset, size), expected) << size;
+      }
+    }
+
+    // A telegram split in two updates, as the framer does
+    uint16_t expected = Crc16::update(Crc16::BYTEWISE, 0xFFFF, data.data(), data.size());
+    for (size_t split : {1, 7, 16, 100, 1111}) {
+      uint16_t crc = Crc16::update(crc_engine, 0xFFFF, data.data(), split);
+      crc = Crc16::update(crc_engine, crc, data.data() + split, data.size() - split);
+      EXPECT_EQ(crc, expected) << split;
+    }
+  }
+}
+
+TEST(Crc16Test, BestEngineIsSupported)
+{
+  EXPECT_TRUE(Crc16::isSupported(Crc16::getBestEngine()));
+  const uint8_t data[] = {0x00, 0x00, 0xFF, 0x07, 0x03, 0x01};
+  EXPECT_EQ(
+    Crc16::update(0xFFFF, data, sizeof(data)),
+    Crc16::update(Crc16::BYTEWISE, 0xFFFF, data, sizeof(data)));
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 Alberto J. Tudela Roldán
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Runs dual_scan_container.launch.py against a front and a rear emulated scanner."""
+
+import os
+import tempfile
+import time
+import unittest
+
+from ament_index_python import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import IncludeLaunchDescription, TimerAction
+from launch.launch_description_sources import PythonLaunchDescriptionSource
+from launch_ros.actions import Node
+import launch_testing.actions
+import pytest
+import rclpy
+from sensor_msgs.msg import LaserScan
+
+
+@pytest.mark.launch_test
+def generate_test_description():
+    sicks300_dir = get_package_share_directory('sicks300_ros2')
+    tmp_dir = tempfile.mkdtemp()
+    front_port = os.path.join(tmp_dir, 'front')
+    rear_port = os.path.join(tmp_dir, 'rear')
+
+    # The parameters of the launch file, with the ports of the emulators
+    with open(os.path.join(sicks300_dir, 'params', 'dual.yaml')) as dual_file:
+        params = dual_file.read()
+    params = params.replace('/dev/ttyUSB0', front_port).replace('/dev/ttyUSB1', rear_port)
+    param_file = os.path.join(tmp_dir, 'dual.yaml')
+    with open(param_file, 'w') as test_file:
+        test_file.write(params)
+
+    # The master scanner (address 7) and the slave one (address 8)
+    emulators = [
+        Node(
+            package='sicks300_ros2',
+            executable='s300_emulator',
+            name=name,
+            arguments=['--address', address, '--link', port],
+            output='screen')
+        for name, address, port in [
+            ('emulator_front', '7', front_port), ('emulator_rear', '8', rear_port)]
+    ]
+
+    # The drivers open the ports once the emulators have linked them
+    dual_container = IncludeLaunchDescription(
+        PythonLaunchDescriptionSource(
+            os.path.join(sicks300_dir, 'launch', 'dual_scan_container.launch.py')),
+        launch_arguments={'sicks300_param_file': param_file}.items())
+
+    return LaunchDescription(emulators + [
+        TimerAction(period=1.0, actions=[dual_container]),
+        launch_testing.actions.ReadyToTest(),
+    ])
+
+
+class TestDualScanContainer(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        rclpy.init()
+
+    @classmethod
+    def tearDownClass(cls):
+        rclpy.shutdown()
+
+    def setUp(self):
+        self.node = rclpy.create_node('test_dual_scan_container')
+
+    def tearDown(self):
+        self.node.destroy_node()
+
+    def test_both_scanners_publish(self):
+        scans = {'scan_front': [], 'scan_rear': []}
+        for topic, received in scans.items():
+            self.node.create_subscription(LaserScan, topic, received.append, 10)
+
+        end_time = time.time() + 20.0
+        while time.time() < end_time and not all(len(r) >= 5 for r in scans.values()):
+            rclpy.spin_once(self.node, timeout_sec=0.1)
+
+        for topic, frame_id in [
+                ('scan_front', 'base_front_laser_link'), ('scan_rear', 'base_rear_laser_link')]:
+            self.assertGreaterEqual(len(scans[topic]), 5, 'Too few scans on ' + topic)
+            for scan in scans[topic]:
+                self.assertEqual(scan.header.frame_id, frame_id)
+                self.assertGreater(len(scan.ranges), 0)
@@ -0,0 +1,134 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/LatencyHistogram.hpp"
+
+namespace
+{
+
+// Largest error of a value reported from its bucket
+void expectWithinBucket(int64_t reported, int64_t value)
+{
+  EXPECT_LE(std::llabs(reported - value), value / LatencyHistogram::SUB_BUCKETS + 1) <<
+    "reported " << reported << " for " << value;
+}
+
+}  // namespace
+
+TEST(LatencyHistogramTest, EmptySummary)
+{
+  LatencyHistogram histogram;
+  LatencyHistogram::Summary summary = histogram.collect();
+  EXPECT_EQ(summary.count, 0u);
+  EXPECT_EQ(summary.p50, 0);
+  EXPECT_EQ(summary.p99, 0);
+  EXPECT_EQ(summary.max, 0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+  LatencyHistogram histogram;
+  for (int64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; value++) {
+    histogram.record(value);
+  }
+  LatencyHistogram::Summary summary = histogram.collect();
+  EXPECT_EQ(summary.count, static_cast<uint64_t>(LatencyHistogram::SUB_BUCKETS));
+  EXPECT_EQ(summary.p50, LatencyHistogram::SUB_BUCKETS / 2 - 1);
+  EXPECT_EQ(summary.p99, LatencyHistogram::SUB_BUCKETS - 1);
+  EXPECT_EQ(summary.max, LatencyHistogram::SUB_BUCKETS - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError)
+{
+  // 1 to 1000 us, so the median is 500 us and the 99th percentile 990 us
+  LatencyHistogram histogram;
+  for (int64_t i = 1; i <= 1000; i++) {
+    histogram.record(i * 1000);
+  }
+  LatencyHistogram::Summary summary = histogram.collect();
+  EXPECT_EQ(summary.count, 1000u);
+  expectWithinBucket(summary.p50, 500000);
+  expectWithinBucket(summary.p99, 990000);
+  EXPECT_EQ(summary.max, 1000000);
+}
+
+TEST(LatencyHistogramTest, MedianOfZeros)
+{
+  LatencyHistogram histogram;
+  for (int i = 0; i < 3; i++) {
+    histogram.record(0);
+  }
+  histogram.record(100000);
+  LatencyHistogram::Summary summary = histogram.collect();
+  EXPECT_EQ(summary.p50, 0);
+  expectWithinBucket(summary.p99, 100000);
+}
+
+TEST(LatencyHistogramTest, NegativeCountedAsZero)
+{
+  LatencyHistogram histogram;
+  histogram.record(-5);
+  LatencyHistogram::Summary summary = histogram.collect();
+  EXPECT_EQ(summary.count, 1u);
+  EXPECT_EQ(summary.p50, 0);
+  EXPECT_EQ(summary.max, 0);
+}
+
+TEST(LatencyHistogramTest, LargeValuesInLastBucket)
+{
+  // 10 s is beyond the last bucket, only the maximum keeps it
+  LatencyHistogram histogram;
+  histogram.record(10000000000);
+  LatencyHistogram::Summary summary = histogram.collect();
+  EXPECT_EQ(summary.count, 1u);
+  EXPECT_GT(summary.p50, (int64_t(1) << LatencyHistogram::MAX_BITS) * 31 / 32);
+  EXPECT_LE(summary.p50, summary.max);
+  EXPECT_EQ(summary.max, 10000000000);
+}
+
+TEST(LatencyHistogramTest, CollectClears)
+{
+  LatencyHistogram histogram;
+  histogram.record(1000);
+  EXPECT_EQ(histogram.collect().count, 1u);
+  LatencyHistogram::Summary summary = histogram.collect();
+  EXPECT_EQ(summary.count, 0u);
+  EXPECT_EQ(summary.max, 0);
+}
+
+TEST(LatencyHistogramTest, RecordsWhileCollecting)
+{
+  // Every value recorded by one thread is collected exactly once by another one
+  const uint64_t values = 100000;
+  LatencyHistogram histogram;
+  std::thread recorder(
+    [&]() {
+      for (uint64_t i = 0; i < values; i++) {
+        histogram.record(static_cast<int64_t>(i % 5000));
+      }
+    });
+  uint64_t collected = 0;
+  while (collected < values) {
+    collected += histogram.collect().count;
+  }
+  recorder.join();
+  collected += histogram.collect().count;
+  EXPECT_EQ(collected, values);
+}
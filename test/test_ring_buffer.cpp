@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/RingBuffer.hpp"
+
+namespace
+{
+
+// Bytes numbered from first, so any view can be checked
+std::vector<unsigned char> makeBytes(size_t first, size_t count)
+{
+  std::vector<unsigned char> bytes(count);
+  for (size_t i = 0; i < count; i++) {
+    bytes[i] = static_cast<unsigned char>(first + i);
+  }
+  return bytes;
+}
+
+}  // namespace
+
+TEST(RingBufferTest, RoundsCapacityToPowerOfTwo)
+{
+  RingBuffer ring(100, 16);
+  EXPECT_EQ(ring.capacity(), 128u);
+  EXPECT_EQ(ring.size(), 0u);
+  EXPECT_EQ(ring.space(), 128u);
+}
+
+TEST(RingBufferTest, StopsWritingWhenFull)
+{
+  RingBuffer ring(64, 16);
+  std::vector<unsigned char> bytes = makeBytes(0, 100);
+  EXPECT_EQ(ring.write(bytes.data(), bytes.size()), 64u);
+  EXPECT_EQ(ring.space(), 0u);
+  EXPECT_EQ(ring.write(bytes.data(), 1), 0u);
+}
+
+TEST(RingBufferTest, ViewsAreContiguousAcrossWrap)
+{
+  const size_t capacity = 64, mirror = 16;
+  RingBuffer ring(capacity, mirror);
+
+  // The positions run past several times the capacity, the views straddling the wrap
+  size_t written = 0;
+  for (int round = 0; round < 20; round++) {
+    std::vector<unsigned char> bytes = makeBytes(written, 40);
+    ASSERT_EQ(ring.write(bytes.data(), bytes.size()), bytes.size());
+    written += bytes.size();
+    ASSERT_EQ(ring.end(), written);
+
+    for (size_t position = ring.begin(); position < ring.end(); position++) {
+      size_t length;
+      const unsigned char * view = ring.readView(position, length);
+      size_t expected_length = ring.end() - position < mirror ? ring.end() - position : mirror;
+      ASSERT_GE(length, expected_length);
+      std::vector<unsigned char> expected = makeBytes(position, expected_length);
+      ASSERT_EQ(std::memcmp(view, expected.data(), expected_length), 0) << position;
+    }
+    ring.release(ring.end());
+    EXPECT_EQ(ring.size(), 0u);
+  }
+}
+
+TEST(RingBufferTest, SplitWriteViewCoversFreeRegion)
+{
+  const size_t capacity = 64, mirror = 16;
+  RingBuffer ring(capacity, mirror);
+
+  // Leave 10 bytes at the end of the storage, the free region then wraps
+  std::vector<unsigned char> bytes = makeBytes(0, 54);
+  ring.write(bytes.data(), bytes.size());
+  ring.release(50);
+
+  size_t length, wrapped_length;
+  unsigned char * wrapped;
+  unsigned char * view = ring.writeView(length, wrapped, wrapped_length);
+  EXPECT_EQ(length, 10u);
+  EXPECT_EQ(wrapped_length, 50u);
+  EXPECT_EQ(length + wrapped_length, ring.space());
+
+  // Filled as readv() would, then read back across the wrap
+  std::vector<unsigned char> fill = makeBytes(54, length + wrapped_length);
+  std::memcpy(view, fill.data(), length);
+  std::memcpy(wrapped, fill.data() + length, wrapped_length);
+  ring.commit(length + wrapped_length);
+  EXPECT_EQ(ring.size(), capacity);
+
+  size_t read_length;
+  const unsigned char * read = ring.readView(60, read_length);
+  ASSERT_GE(read_length, mirror);
+  std::vector<unsigned char> expected = makeBytes(60, mirror);
+  EXPECT_EQ(std::memcmp(read, expected.data(), mirror), 0);
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/ScanClock.hpp"
+
+namespace
+{
+
+// The scanner oscillator runs slightly slower than the nominal 40 ms
+const double c_dPeriod = 0.0401;
+
+// Delay of the fastest arrival, added to every scan
+const int64_t c_iMinDelayNs = 2000000;
+
+// Host time at which a scan is sent, from scan 1000 at 5 s
+int64_t sendTime(unsigned int scan_number)
+{
+  return 5000000000LL + static_cast<int64_t>((scan_number - 1000.0) * c_dPeriod * 1e9);
+}
+
+// Arrival with a delay between 0 and 0.5 ms over the minimum, repeating every 5 scans
+int64_t arrivalTime(unsigned int scan_number)
+{
+  return sendTime(scan_number) + c_iMinDelayNs + (scan_number % 5) * 100000;
+}
+
+// Feeds count scans from first, returning the number rejected
+unsigned int feed(ScanClock & clock, unsigned int first, unsigned int count)
+{
+  unsigned int rejected = 0;
+  for (unsigned int scan = first; scan < first + count; scan++) {
+    rejected += !clock.update(scan, arrivalTime(scan));
+  }
+  return rejected;
+}
+
+}  // namespace
+
+TEST(ScanClockTest, ReadyAfterMinSamples)
+{
+  ScanClock clock;
+  feed(clock, 1000, ScanClock::MIN_SAMPLES - 1);
+  EXPECT_FALSE(clock.isReady());
+  feed(clock, 1000 + ScanClock::MIN_SAMPLES - 1, 1);
+  EXPECT_TRUE(clock.isReady());
+}
+
+TEST(ScanClockTest, FitsScannerPeriod)
+{
+  ScanClock clock;
+  EXPECT_EQ(feed(clock, 1000, 300), 0u);
+  ASSERT_TRUE(clock.isReady());
+  EXPECT_NEAR(clock.getPeriod(), c_dPeriod, 1e-6);
+
+  // The scans are stamped at their least delayed arrival, past and future ones alike
+  for (unsigned int scan : {1200u, 1299u, 1310u}) {
+    EXPECT_NEAR(clock.toTime(scan), sendTime(scan) + c_iMinDelayNs, 50000) << scan;
+  }
+}
+
+TEST(ScanClockTest, IgnoresRepeatedScanNumber)
+{
+  // The telegrams of the other fields carry the same scan number
+  ScanClock clock;
+  feed(clock, 1000, 100);
+  int64_t before = clock.toTime(1100);
+  EXPECT_TRUE(clock.update(1099, arrivalTime(1099) + 30000000));
+  EXPECT_EQ(clock.toTime(1100), before);
+  EXPECT_EQ(clock.getRejected(), 0u);
+}
+
+TEST(ScanClockTest, RejectsDelayedSample)
+{
+  ScanClock clock;
+  feed(clock, 1000, 100);
+  int64_t before = clock.toTime(1110);
+
+  // The reader was scheduled 20 ms late
+  EXPECT_FALSE(clock.update(1100, arrivalTime(1100) + 20000000));
+  EXPECT_EQ(clock.getRejected(), 1u);
+  EXPECT_EQ(clock.toTime(1110), before);
+
+  // An early sample lowers the envelope instead of being rejected
+  EXPECT_TRUE(clock.update(1101, sendTime(1101) + c_iMinDelayNs - 100000));
+  EXPECT_EQ(feed(clock, 1102, 10), 0u);
+}
+
+TEST(ScanClockTest, RestartsOnScanNumberJump)
+{
+  ScanClock clock;
+  feed(clock, 1000, 100);
+  ASSERT_TRUE(clock.isReady());
+
+  // The scanner restarted and counts from 0 again
+  EXPECT_TRUE(clock.update(0, arrivalTime(1100)));
+  EXPECT_FALSE(clock.isReady());
+
+  // So does a gap larger than MAX_SCAN_GAP
+  feed(clock, 1000, 100);
+  ASSERT_TRUE(clock.isReady());
+  EXPECT_TRUE(clock.update(1100 + ScanClock::MAX_SCAN_GAP + 1, arrivalTime(1100)));
+  EXPECT_FALSE(clock.isReady());
+}
+
+TEST(ScanClockTest, RestartsAfterHostClockJump)
+{
+  ScanClock clock;
+  feed(clock, 1000, 100);
+
+  // Every sample is 1 s late after the jump, the model restarts instead of rejecting forever
+  const int64_t jump = 1000000000LL;
+  unsigned int rejected = 0;
+  unsigned int scan = 1100;
+  for (; scan < 1100 + ScanClock::MAX_REJECTED + 1; scan++) {
+    rejected += !clock.update(scan, arrivalTime(scan) + jump);
+  }
+  EXPECT_EQ(rejected, static_cast<unsigned int>(ScanClock::MAX_REJECTED + 1));
+  EXPECT_FALSE(clock.isReady());
+
+  for (; scan < 1200; scan++) {
+    EXPECT_TRUE(clock.update(scan, arrivalTime(scan) + jump));
+  }
+  ASSERT_TRUE(clock.isReady());
+  EXPECT_NEAR(clock.toTime(1199), sendTime(1199) + c_iMinDelayNs + jump, 50000);
+}
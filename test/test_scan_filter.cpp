@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/scan_filter.hpp"
+
+using sicks300_ros2::ScanFilter;
+
+namespace
+{
+
+// Scan of size beams every 0.01 rad from -1 rad, the range of each beam being its index
+sensor_msgs::msg::LaserScan makeScan(size_t size, size_t num_intensities)
+{
+  sensor_msgs::msg::LaserScan scan;
+  scan.angle_min = -1.0f;
+  scan.angle_increment = 0.01f;
+  scan.angle_max = scan.angle_min + (size - 1) * scan.angle_increment;
+  for (size_t i = 0; i < size; i++) {
+    scan.ranges.push_back(static_cast<float>(i));
+  }
+  for (size_t i = 0; i < num_intensities; i++) {
+    scan.intensities.push_back(static_cast<float>(100 + i));
+  }
+  return scan;
+}
+
+}  // namespace
+
+TEST(ScanFilterTest, CropsRangesAndIntensities)
+{
+  sensor_msgs::msg::LaserScan scan = makeScan(100, 100);
+  ScanFilter::crop_scan(scan, 10, 20);
+
+  ASSERT_EQ(scan.ranges.size(), 20u);
+  ASSERT_EQ(scan.intensities.size(), 20u);
+  EXPECT_EQ(scan.ranges.front(), 10.0f);
+  EXPECT_EQ(scan.ranges.back(), 29.0f);
+  EXPECT_EQ(scan.intensities.front(), 110.0f);
+  EXPECT_EQ(scan.intensities.back(), 129.0f);
+  EXPECT_FLOAT_EQ(scan.angle_min, -0.9f);
+  EXPECT_FLOAT_EQ(scan.angle_max, -0.71f);
+}
+
+TEST(ScanFilterTest, DropsShortIntensities)
+{
+  // Intensities ending inside the window cannot match the ranges
+  sensor_msgs::msg::LaserScan scan = makeScan(100, 25);
+  ScanFilter::crop_scan(scan, 10, 20);
+  EXPECT_EQ(scan.ranges.size(), 20u);
+  EXPECT_TRUE(scan.intensities.empty());
+
+  // Those covering the window are kept
+  scan = makeScan(100, 30);
+  ScanFilter::crop_scan(scan, 10, 20);
+  EXPECT_EQ(scan.intensities.size(), 20u);
+
+  // And none stay none
+  scan = makeScan(100, 0);
+  ScanFilter::crop_scan(scan, 10, 20);
+  EXPECT_EQ(scan.ranges.size(), 20u);
+  EXPECT_TRUE(scan.intensities.empty());
+}
+
+TEST(ScanFilterTest, CropsToEmptyScan)
+{
+  sensor_msgs::msg::LaserScan scan = makeScan(100, 100);
+  ScanFilter::crop_scan(scan, 100, 0);
+  EXPECT_TRUE(scan.ranges.empty());
+  EXPECT_TRUE(scan.intensities.empty());
+  EXPECT_FLOAT_EQ(scan.angle_min, scan.angle_max);
+}
+
+TEST(ScanFilterTest, WindowInsideScan)
+{
+  // 201 beams from -1 to 1 rad
+  size_t first, count;
+  ScanFilter::compute_window(-0.5, 0.5, -1.0f, 0.01f, 201, first, count);
+  EXPECT_EQ(first, 50u);
+  EXPECT_EQ(count, 101u);
+
+  // Bounds between two beams
+  ScanFilter::compute_window(-0.505, 0.505, -1.0f, 0.01f, 201, first, count);
+  EXPECT_EQ(first, 50u);
+  EXPECT_EQ(count, 101u);
+}
+
+TEST(ScanFilterTest, WindowClampedToScan)
+{
+  size_t first, count;
+  ScanFilter::compute_window(-10.0, 10.0, -1.0f, 0.01f, 201, first, count);
+  EXPECT_EQ(first, 0u);
+  EXPECT_EQ(count, 201u);
+}
+
+TEST(ScanFilterTest, WindowLowerAfterLastBeam)
+{
+  size_t first, count;
+  ScanFilter::compute_window(1.5, 2.0, -1.0f, 0.01f, 201, first, count);
+  EXPECT_EQ(first, 201u);
+  EXPECT_EQ(count, 0u);
+
+  // The cropped scan is then empty
+  sensor_msgs::msg::LaserScan scan = makeScan(201, 201);
+  ScanFilter::crop_scan(scan, first, count);
+  EXPECT_TRUE(scan.ranges.empty());
+}
+
+TEST(ScanFilterTest, WindowUpperBeforeLower)
+{
+  // Only the first beam after the lower bound is kept
+  size_t first, count;
+  ScanFilter::compute_window(0.5, -0.5, -1.0f, 0.01f, 201, first, count);
+  EXPECT_EQ(first, 150u);
+  EXPECT_EQ(count, 1u);
+
+  // So is the first beam if the upper bound is before the scan
+  ScanFilter::compute_window(-2.0, -1.5, -1.0f, 0.01f, 201, first, count);
+  EXPECT_EQ(first, 0u);
+  EXPECT_EQ(count, 1u);
+}
+
+TEST(ScanFilterTest, WindowDefaultBounds)
+{
+  // Both bounds at 0 keep the beam at 0
+  size_t first, count;
+  ScanFilter::compute_window(0.0, 0.0, -1.0f, 0.01f, 201, first, count);
+  EXPECT_EQ(first, 100u);
+  EXPECT_EQ(count, 1u);
+}
+
+TEST(ScanFilterTest, WindowOfDegenerateScan)
+{
+  size_t first, count;
+  ScanFilter::compute_window(-0.5, 0.5, -1.0f, 0.0f, 201, first, count);
+  EXPECT_EQ(first, 0u);
+  EXPECT_EQ(count, 201u);
+
+  ScanFilter::compute_window(-0.5, 0.5, -1.0f, 0.01f, 0, first, count);
+  EXPECT_EQ(first, 0u);
+  EXPECT_EQ(count, 0u);
+}
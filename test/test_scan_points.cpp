@@ -0,0 +1,118 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/ScanPoints.hpp"
+
+namespace
+{
+
+const float c_fRangeMin = 0.001f;
+const float c_fRangeMax = 29.5f;
+
+// Sizes around the vector widths and of the scans of the S300
+const size_t c_Sizes[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 541, 1082};
+
+struct Scan
+{
+  std::vector<float> ranges, intensities, sin_table, cos_table;
+};
+
+// Beams over 270 degrees, with out of range, boundary and NaN ranges mixed in
+Scan makeScan(size_t size)
+{
+  Scan scan;
+  for (size_t i = 0; i < size; i++) {
+    float angle = -2.36f + 4.72f * static_cast<float>(i) / static_cast<float>(size);
+    scan.sin_table.push_back(std::sin(angle));
+    scan.cos_table.push_back(std::cos(angle));
+    scan.intensities.push_back(static_cast<float>(i % 256));
+    float range = 0.01f * static_cast<float>(i % 3000);
+    switch (i % 11) {
+      case 2: range = 0.0f; break;
+      case 5: range = c_fRangeMax + 1.0f; break;
+      case 7: range = c_fRangeMin; break;
+      case 8: range = c_fRangeMax; break;
+      case 10: range = NAN; break;
+      default: break;
+    }
+    scan.ranges.push_back(range);
+  }
+  return scan;
+}
+
+// Converts into a buffer of the exact size documented, so an overrun is caught by ASan
+std::vector<float> convert(ScanPoints::Engine engine, const Scan & scan)
+{
+  size_t size = scan.ranges.size();
+  std::vector<float> points(ScanPoints::POINT_FIELDS * size);
+  size_t count = ScanPoints::convert(
+    engine, scan.ranges.data(), scan.intensities.data(), scan.sin_table.data(),
+    scan.cos_table.data(), size, c_fRangeMin, c_fRangeMax, points.data());
+  points.resize(ScanPoints::POINT_FIELDS * count);
+  return points;
+}
+
+}  // namespace
+
+TEST(ScanPointsTest, ScalarKeepsBeamsInRange)
+{
+  Scan scan = makeScan(22);
+  std::vector<float> points = convert(ScanPoints::SCALAR, scan);
+
+  std::vector<float> expected;
+  for (size_t i = 0; i < scan.ranges.size(); i++) {
+    float range = scan.ranges[i];
+    if (range >= c_fRangeMin && range <= c_fRangeMax) {
+      expected.insert(
+        expected.end(),
+        {range * scan.cos_table[i], range * scan.sin_table[i], 0.0f, scan.intensities[i]});
+    }
+  }
+  EXPECT_EQ(points, expected);
+}
+
+TEST(ScanPointsTest, EnginesMatchScalar)
+{
+  for (int engine = ScanPoints::SSE; engine < ScanPoints::NUM_ENGINES; engine++) {
+    if (!ScanPoints::isSupported(static_cast<ScanPoints::Engine>(engine))) {continue;}
+    SCOPED_TRACE(ScanPoints::getName(static_cast<ScanPoints::Engine>(engine)));
+    for (size_t size : c_Sizes) {
+      SCOPED_TRACE(size);
+      Scan scan = makeScan(size);
+      EXPECT_EQ(
+        convert(static_cast<ScanPoints::Engine>(engine), scan),
+        convert(ScanPoints::SCALAR, scan));
+    }
+  }
+}
+
+TEST(ScanPointsTest, BestEngineIsSupported)
+{
+  EXPECT_TRUE(ScanPoints::isSupported(ScanPoints::SCALAR));
+  EXPECT_TRUE(ScanPoints::isSupported(ScanPoints::getBestEngine()));
+
+  // convert() without engine uses the best one
+  Scan scan = makeScan(541);
+  std::vector<float> points(ScanPoints::POINT_FIELDS * scan.ranges.size());
+  size_t count = ScanPoints::convert(
+    scan.ranges.data(), scan.intensities.data(), scan.sin_table.data(),
+    scan.cos_table.data(), scan.ranges.size(), c_fRangeMin, c_fRangeMax, points.data());
+  points.resize(ScanPoints::POINT_FIELDS * count);
+  EXPECT_EQ(points, convert(ScanPoints::SCALAR, scan));
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/ScannerSickS300.hpp"
+#include "sicks300_ros2/common/TelegramGenerator.hpp"
+
+namespace
+{
+
+const size_t c_iNumBeams = 541;
+
+// Feeds a scan followed by a reflector telegram with the given words, and decodes them
+const ScannerSickS300::ReflectorData * decodeReflectors(
+  ScannerSickS300 & scanner, const std::vector<uint16_t> & words, bool inverted)
+{
+  ScannerSickS300::ParamType param;
+  param.range_field = 1;
+  param.dScale = 0.01;
+  param.dStartAngle = -2.36;
+  param.dStopAngle = 2.36;
+  scanner.setRangeField(1, param);
+
+  TelegramGenerator::Options options;
+  options.num_beams = c_iNumBeams;
+  TelegramGenerator generator(options);
+  const std::vector<unsigned char> & scan = generator.next();
+  scanner.feed(scan.data(), scan.size());
+  const std::vector<unsigned char> & reflectors = generator.nextReflectors(words);
+  scanner.feed(reflectors.data(), reflectors.size());
+
+  std::vector<float> ranges, intensities;
+  const ScannerSickS300::ScanGeometry * geometry;
+  unsigned int scan_number;
+  EXPECT_TRUE(scanner.nextScan(ranges, intensities, geometry, scan_number, inverted, false));
+  return scanner.takeReflectors();
+}
+
+}  // namespace
+
+TEST(ScannerSickS300Test, DecodesReflectors)
+{
+  for (bool inverted : {false, true}) {
+    SCOPED_TRACE(inverted);
+    ScannerSickS300 scanner;
+    const ScannerSickS300::ReflectorData * data =
+      decodeReflectors(scanner, {10, 12, 250, 0, 540, 300}, inverted);
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(data->vReflectors.size(), 2u);
+
+    const ScannerSickS300::Reflector & first = data->vReflectors[0];
+    EXPECT_EQ(first.iFirstBeam, inverted ? 528u : 10u);
+    EXPECT_EQ(first.iLastBeam, inverted ? 530u : 12u);
+    EXPECT_DOUBLE_EQ(first.dDistanceM, 2.5);
+    EXPECT_EQ(data->vReflectors[1].iFirstBeam, 0u);
+    EXPECT_EQ(data->vReflectors[1].iLastBeam, c_iNumBeams - 1);
+  }
+}
+
+TEST(ScannerSickS300Test, SkipsReflectorsOutOfScan)
+{
+  // Beams past the last one or in reverse order, as in a corrupt telegram
+  for (bool inverted : {false, true}) {
+    SCOPED_TRACE(inverted);
+    ScannerSickS300 scanner;
+    const ScannerSickS300::ReflectorData * data = decodeReflectors(
+      scanner, {20, 22, 100, 530, 541, 100, 0xFFFF, 0xFFFF, 100, 40, 30, 100}, inverted);
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(data->vReflectors.size(), 1u);
+    const ScannerSickS300::Reflector & reflector = data->vReflectors[0];
+    EXPECT_EQ(reflector.iFirstBeam, inverted ? 518u : 20u);
+    EXPECT_EQ(reflector.iLastBeam, inverted ? 520u : 22u);
+    EXPECT_GE(reflector.dAngle, -2.36);
+    EXPECT_LE(reflector.dAngle, 2.36);
+  }
+}
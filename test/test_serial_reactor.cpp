@@ -0,0 +1,133 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+// C++
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/ScannerSickS300.hpp"
+#include "sicks300_ros2/common/SerialReactor.hpp"
+#include "sicks300_ros2/common/TelegramGenerator.hpp"
+
+namespace
+{
+
+// A scanner emulated on a pseudo-terminal, read by a reactor run from the test
+class SerialReactorTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char name[256];
+    ASSERT_EQ(openpty(&master_, &slave_, name, nullptr, nullptr), 0);
+    termios tio;
+    tcgetattr(slave_, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave_, TCSANOW, &tio);
+    ASSERT_TRUE(scanner_.open(name, 500000, 7));
+
+    ScannerSickS300::ParamType param;
+    param.range_field = 1;
+    param.dScale = 0.01;
+    param.dStartAngle = -2.36;
+    param.dStopAngle = 2.36;
+    scanner_.setRangeField(1, param);
+
+    // The slave is only kept open by the scanner, as the driver does with a real port
+    close(slave_);
+  }
+
+  void TearDown() override
+  {
+    reactor_.remove(scanner_);
+    if (master_ >= 0) {close(master_);}
+  }
+
+  // Runs the reactor until the condition holds, at most a second
+  template<typename Condition>
+  bool runUntil(Condition condition)
+  {
+    for (int i = 0; i < 100 && !condition(); i++) {
+      reactor_.runOnce(0.01);
+    }
+    return condition();
+  }
+
+  int master_ = -1, slave_ = -1;
+  ScannerSickS300 scanner_;
+  SerialReactor reactor_;
+};
+
+}  // namespace
+
+TEST_F(SerialReactorTest, DeliversScans)
+{
+  int scans = 0;
+  SerialReactor::Options options;
+  ASSERT_TRUE(reactor_.add(scanner_, options, [&](SerialReactor::Scan &) {scans++;}));
+
+  TelegramGenerator generator{TelegramGenerator::Options()};
+  for (int i = 0; i < 3; i++) {
+    const std::vector<unsigned char> & telegram = generator.next();
+    ASSERT_EQ(write(master_, telegram.data(), telegram.size()),
+      static_cast<ssize_t>(telegram.size()));
+    int expected = i + 1;
+    EXPECT_TRUE(runUntil([&]() {return scans == expected;}));
+  }
+  EXPECT_FALSE(scanner_.isPortLost());
+}
+
+TEST_F(SerialReactorTest, FindsClosedPort)
+{
+  int timeouts = 0;
+  SerialReactor::Options options;
+  options.timeout = 0.05;
+  ASSERT_TRUE(
+    reactor_.add(
+      scanner_, options, [](SerialReactor::Scan &) {}, [&]() {timeouts++;}));
+
+  // The other end goes away, like an emulator that exits
+  close(master_);
+  master_ = -1;
+  EXPECT_TRUE(runUntil([&]() {return scanner_.isPortLost();}));
+
+  // The timeouts go on, so the user can tell them from a lost port
+  EXPECT_TRUE(runUntil([&]() {return timeouts > 0;}));
+  EXPECT_TRUE(scanner_.isPortLost());
+}
+
+TEST_F(SerialReactorTest, FindsPortClosedMidTelegram)
+{
+  SerialReactor::Options options;
+  ASSERT_TRUE(reactor_.add(scanner_, options, [](SerialReactor::Scan &) {}));
+
+  // Half a telegram leaves the port out of the wait until the rest is due, so the hang up
+  // is reported without data to read
+  scanner_.setAdaptiveReads(true);
+  TelegramGenerator generator{TelegramGenerator::Options()};
+  const std::vector<unsigned char> & telegram = generator.next();
+  size_t half = telegram.size() / 2;
+  ASSERT_EQ(write(master_, telegram.data(), half), static_cast<ssize_t>(half));
+  ASSERT_EQ(reactor_.runOnce(1.0), 1);
+  ASSERT_GT(scanner_.getTelegramWait(), 0.0);
+
+  close(master_);
+  master_ = -1;
+  EXPECT_TRUE(runUntil([&]() {return scanner_.isPortLost();}));
+}
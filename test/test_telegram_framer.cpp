@@ -0,0 +1,240 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// C++
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sicks300_ros2/common/TelegramFramer.hpp"
+#include "sicks300_ros2/common/TelegramGenerator.hpp"
+
+namespace
+{
+
+const TelegramGenerator::Protocol c_Protocols[] = {
+  TelegramGenerator::PROTOCOL_0102,
+  TelegramGenerator::PROTOCOL_0301,
+  TelegramGenerator::PROTOCOL_0301_FIELDS
+};
+
+struct Frame
+{
+  size_t start;
+  size_t length;
+
+  bool operator==(const Frame & other) const
+  {
+    return start == other.start && length == other.length;
+  }
+};
+
+// Telegrams of consecutive scans sent back to back, with the frame of each one
+std::vector<unsigned char> makeStream(
+  TelegramGenerator::Protocol protocol, size_t count, std::vector<Frame> & frames,
+  unsigned char device_address = 7)
+{
+  TelegramGenerator::Options options;
+  options.protocol = protocol;
+  options.num_beams = 100;
+  options.device_address = device_address;
+  TelegramGenerator generator(options);
+
+  std::vector<unsigned char> bytes;
+  frames.clear();
+  for (size_t i = 0; i < count; i++) {
+    const std::vector<unsigned char> & telegram = generator.next();
+    frames.push_back({bytes.size(), telegram.size()});
+    bytes.insert(bytes.end(), telegram.begin(), telegram.end());
+  }
+  return bytes;
+}
+
+// Frames a buffer received at once
+std::vector<Frame> frameAll(const std::vector<unsigned char> & bytes, TelegramFramer & framer)
+{
+  std::vector<Frame> frames;
+  size_t start, length;
+  while (framer.next(bytes.data(), bytes.size(), start, length)) {
+    frames.push_back({start, length});
+  }
+  return frames;
+}
+
+// Frames a buffer received one byte at a time, removing the bytes the framer no longer
+// needs, as ScannerSickS300 does
+std::vector<Frame> frameByteByByte(const std::vector<unsigned char> & bytes)
+{
+  TelegramFramer framer;
+  std::vector<Frame> frames;
+  size_t consumed = 0;
+  for (size_t end = 1; end <= bytes.size(); end++) {
+    while (true) {
+      size_t start, length;
+      bool found = framer.next(bytes.data() + consumed, end - consumed, start, length);
+      if (found) {
+        frames.push_back({consumed + start, length});
+      }
+      size_t discard = framer.discardable();
+      framer.consume(discard);
+      consumed += discard;
+      if (!found && discard == 0) {break;}
+    }
+  }
+  return frames;
+}
+
+}  // namespace
+
+TEST(TelegramFramerTest, FramesBackToBackTelegrams)
+{
+  for (TelegramGenerator::Protocol protocol : c_Protocols) {
+    SCOPED_TRACE(protocol);
+    std::vector<Frame> expected;
+    std::vector<unsigned char> bytes = makeStream(protocol, 10, expected);
+
+    TelegramFramer framer;
+    EXPECT_EQ(frameAll(bytes, framer), expected);
+    EXPECT_EQ(framer.getCrcErrors(), 0u);
+    EXPECT_EQ(frameByteByByte(bytes), expected);
+  }
+}
+
+TEST(TelegramFramerTest, SkipsLeadingGarbage)
+{
+  for (TelegramGenerator::Protocol protocol : c_Protocols) {
+    SCOPED_TRACE(protocol);
+    std::vector<Frame> expected;
+    std::vector<unsigned char> bytes = makeStream(protocol, 5, expected);
+
+    // The tail of a previous telegram, with a run of zeros and a coordination flag
+    std::vector<unsigned char> garbage = {0x12, 0, 0, 0, 0, 0, 0, 0x01, 0xFF, 0x07, 0x34};
+    bytes.insert(bytes.begin(), garbage.begin(), garbage.end());
+    for (Frame & frame : expected) {
+      frame.start += garbage.size();
+    }
+
+    TelegramFramer framer;
+    EXPECT_EQ(frameAll(bytes, framer), expected);
+    EXPECT_EQ(frameByteByByte(bytes), expected);
+  }
+}
+
+TEST(TelegramFramerTest, ResyncsAfterBitError)
+{
+  for (TelegramGenerator::Protocol protocol : c_Protocols) {
+    SCOPED_TRACE(protocol);
+    std::vector<Frame> frames;
+    std::vector<unsigned char> bytes = makeStream(protocol, 6, frames);
+
+    // A bit flipped in the measurements of the second telegram and in the size of the fourth
+    bytes[frames[1].start + frames[1].length / 2] ^= 0x10;
+    bytes[frames[3].start + 7] ^= 0x01;
+    std::vector<Frame> expected = {frames[0], frames[2], frames[4], frames[5]};
+
+    TelegramFramer framer;
+    EXPECT_EQ(frameAll(bytes, framer), expected);
+    EXPECT_GE(framer.getCrcErrors(), 1u);
+    EXPECT_EQ(frameByteByByte(bytes), expected);
+  }
+}
+
+TEST(TelegramFramerTest, ResyncsAfterTruncation)
+{
+  for (TelegramGenerator::Protocol protocol : c_Protocols) {
+    SCOPED_TRACE(protocol);
+    std::vector<Frame> frames;
+    std::vector<unsigned char> bytes = makeStream(protocol, 5, frames);
+
+    // The second half of the second telegram is lost
+    size_t lost = frames[1].length - frames[1].length / 2;
+    bytes.erase(
+      bytes.begin() + frames[1].start + frames[1].length / 2,
+      bytes.begin() + frames[1].start + frames[1].length);
+    std::vector<Frame> expected = {frames[0]};
+    for (size_t i = 2; i < frames.size(); i++) {
+      expected.push_back({frames[i].start - lost, frames[i].length});
+    }
+
+    TelegramFramer framer;
+    EXPECT_EQ(frameAll(bytes, framer), expected);
+    EXPECT_EQ(frameByteByByte(bytes), expected);
+  }
+}
+
+TEST(TelegramFramerTest, WaitsForIncompleteTelegram)
+{
+  std::vector<Frame> frames;
+  std::vector<unsigned char> bytes =
+    makeStream(TelegramGenerator::PROTOCOL_0301, 1, frames);
+
+  TelegramFramer framer;
+  size_t start, length;
+  EXPECT_FALSE(framer.next(bytes.data(), bytes.size() - 1, start, length));
+  EXPECT_EQ(framer.missing(bytes.size() - 1), 1u);
+  ASSERT_TRUE(framer.next(bytes.data(), bytes.size(), start, length));
+  EXPECT_EQ(start, 0u);
+  EXPECT_EQ(length, bytes.size());
+}
+
+TEST(TelegramFramerTest, RelearnsSizeRule)
+{
+  // The size rule of the first telegrams is kept until it fails MAX_SIZE_RULE_FAILURES times
+  std::vector<Frame> first, second;
+  std::vector<unsigned char> bytes = makeStream(TelegramGenerator::PROTOCOL_0301, 3, first);
+  std::vector<unsigned char> fields = makeStream(
+    TelegramGenerator::PROTOCOL_0301_FIELDS, 3 + TelegramFramer::MAX_SIZE_RULE_FAILURES, second);
+  for (Frame & frame : second) {
+    frame.start += bytes.size();
+  }
+  bytes.insert(bytes.end(), fields.begin(), fields.end());
+
+  TelegramFramer framer;
+  std::vector<Frame> found = frameAll(bytes, framer);
+  ASSERT_GE(found.size(), first.size() + 3);
+  EXPECT_TRUE(std::equal(first.begin(), first.end(), found.begin()));
+  EXPECT_TRUE(std::equal(second.end() - 3, second.end(), found.end() - 3));
+}
+
+TEST(TelegramFramerTest, SkipsOtherDeviceAddress)
+{
+  for (TelegramGenerator::Protocol protocol : c_Protocols) {
+    SCOPED_TRACE(protocol);
+    // The telegrams of a master (7) and a slave scanner (8) on the same line
+    std::vector<Frame> master, slave;
+    std::vector<unsigned char> master_bytes = makeStream(protocol, 3, master, 7);
+    std::vector<unsigned char> slave_bytes = makeStream(protocol, 3, slave, 8);
+    std::vector<unsigned char> bytes;
+    std::vector<Frame> all, expected;
+    for (size_t i = 0; i < master.size(); i++) {
+      all.push_back({bytes.size(), master[i].length});
+      bytes.insert(
+        bytes.end(), master_bytes.begin() + master[i].start,
+        master_bytes.begin() + master[i].start + master[i].length);
+      all.push_back({bytes.size(), slave[i].length});
+      expected.push_back(all.back());
+      bytes.insert(
+        bytes.end(), slave_bytes.begin() + slave[i].start,
+        slave_bytes.begin() + slave[i].start + slave[i].length);
+    }
+
+    TelegramFramer framer;
+    EXPECT_EQ(frameAll(bytes, framer), all);
+
+    TelegramFramer slave_framer;
+    slave_framer.setDeviceAddress(8);
+    EXPECT_EQ(frameAll(bytes, slave_framer), expected);
+    EXPECT_EQ(slave_framer.getCrcErrors(), 0u);
+  }
+}
@@ -0,0 +1,359 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Emulates an S300 in continuous data output mode on a pseudo-terminal, so the driver can
+// be run without a scanner by setting its port to the printed device (or to --link).
+//
+// Usage: s300_emulator [options], see usage() below.
+
+// C
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <pty.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+// C++
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sicks300_ros2/common/TelegramGenerator.hpp"
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+volatile sig_atomic_t g_running = 1;
+
+void stop(int)
+{
+  g_running = 0;
+}
+
+struct Settings
+{
+  TelegramGenerator::Options telegram;
+  std::vector<int> fields;       // fields sent in every scan, in this order
+  double rate = 25.0;            // telegrams per second, 0 to send them back to back
+  int baud = 500000;             // line rate the bytes are paced at, 0 to write at once
+  size_t chunk = 64;             // bytes written at once, as a USB adapter delivers them
+  unsigned int standby_period = 0;
+  unsigned int standby_length = 0;
+  double bit_errors = 0.0;       // probability of a telegram with a flipped bit
+  double truncations = 0.0;      // probability of a telegram cut short
+  bool reflectors = false;       // send a reflector telegram after every scan
+  bool io = false;               // send an I/O telegram after every scan
+  unsigned long count = 0;       // telegrams to send, 0 for no limit
+  std::string link;
+  unsigned int seed = 42;
+};
+
+struct Statistics
+{
+  unsigned long telegrams = 0;
+  unsigned long standby = 0;
+  unsigned long bit_errors = 0;
+  unsigned long truncations = 0;
+  unsigned long dropped_bytes = 0;
+};
+
+void usage(const char * name)
+{
+  std::printf(
+    "Usage: %s [options]\n"
+    "  -p, --protocol NAME     0102, 0301 or 0301-fields (default 0301)\n"
+    "  -r, --rate HZ           telegrams per second, 0 back to back (default 25)\n"
+    "  -n, --beams N           measurements per telegram (default 541)\n"
+    "  -f, --field N[,N...]    measurement fields 1 to 5 sent in every scan (default 1)\n"
+    "  -a, --address N         device address, 7 or 8 for a slave (default 7)\n"
+    "  -b, --baud N            line rate the bytes are paced at, 0 unpaced (default 500000)\n"
+    "  -c, --chunk N           bytes written at once (default 64)\n"
+    "  -s, --standby N:M       report standby in the last M of every N scans\n"
+    "  -e, --bit-errors P      probability of flipping a bit of a telegram\n"
+    "  -t, --truncations P     probability of cutting a telegram short\n"
+    "  -R, --reflectors        send a reflector telegram after every scan\n"
+    "  -I, --io                send an I/O telegram after every scan\n"
+    "  -l, --count N           stop after N scans\n"
+    "  -L, --link PATH         symbolic link to the pseudo-terminal, replaces only a link\n"
+    "  -S, --seed N            seed of the injected errors (default 42)\n",
+    name);
+}
+
+bool parseArguments(int argc, char ** argv, Settings & settings)
+{
+  const option options[] = {
+    {"protocol", required_argument, nullptr, 'p'},
+    {"rate", required_argument, nullptr, 'r'},
+    {"beams", required_argument, nullptr, 'n'},
+    {"field", required_argument, nullptr, 'f'},
+    {"address", required_argument, nullptr, 'a'},
+    {"baud", required_argument, nullptr, 'b'},
+    {"chunk", required_argument, nullptr, 'c'},
+    {"standby", required_argument, nullptr, 's'},
+    {"bit-errors", required_argument, nullptr, 'e'},
+    {"truncations", required_argument, nullptr, 't'},
+    {"reflectors", no_argument, nullptr, 'R'},
+    {"io", no_argument, nullptr, 'I'},
+    {"count", required_argument, nullptr, 'l'},
+    {"link", required_argument, nullptr, 'L'},
+    {"seed", required_argument, nullptr, 'S'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int c;
+  while ((c = getopt_long(argc, argv, "p:r:n:f:a:b:c:s:e:t:RIl:L:S:h", options, nullptr)) != -1) {
+    switch (c) {
+      case 'p':
+        if (!TelegramGenerator::parseProtocol(optarg, settings.telegram.protocol)) {
+          std::fprintf(stderr, "Unknown protocol '%s'\n", optarg);
+          return false;
+        }
+        break;
+      case 'r': settings.rate = std::atof(optarg); break;
+      case 'n': settings.telegram.num_beams = std::strtoul(optarg, nullptr, 10); break;
+      case 'f':
+        settings.fields.clear();
+        for (char * field = optarg; *field != '\0'; ) {
+          settings.fields.push_back(static_cast<int>(std::strtol(field, &field, 10)));
+          if (*field == ',') {
+            field++;
+          } else if (*field != '\0') {
+            std::fprintf(stderr, "The fields must be a list like 1,2\n");
+            return false;
+          }
+        }
+        break;
+      case 'a':
+        settings.telegram.device_address = static_cast<unsigned char>(std::atoi(optarg));
+        break;
+      case 'b': settings.baud = std::atoi(optarg); break;
+      case 'c': settings.chunk = std::strtoul(optarg, nullptr, 10); break;
+      case 's':
+        if (std::sscanf(optarg, "%u:%u", &settings.standby_period,
+          &settings.standby_length) != 2)
+        {
+          std::fprintf(stderr, "The standby pattern must be N:M\n");
+          return false;
+        }
+        break;
+      case 'e': settings.bit_errors = std::atof(optarg); break;
+      case 't': settings.truncations = std::atof(optarg); break;
+      case 'R': settings.reflectors = true; break;
+      case 'I': settings.io = true; break;
+      case 'l': settings.count = std::strtoul(optarg, nullptr, 10); break;
+      case 'L': settings.link = optarg; break;
+      case 'S': settings.seed = static_cast<unsigned int>(std::strtoul(optarg, nullptr, 10)); break;
+      default:
+        return false;
+    }
+  }
+
+  if (settings.fields.empty()) {
+    settings.fields.push_back(settings.telegram.field);
+  }
+  for (int field : settings.fields) {
+    if (field < 1 || field > 5) {
+      std::fprintf(stderr, "The fields must be between 1 and 5\n");
+      return false;
+    }
+  }
+  if (settings.telegram.num_beams == 0 || settings.chunk == 0) {
+    std::fprintf(stderr, "The beams and the chunk size must be positive\n");
+    return false;
+  }
+  return true;
+}
+
+// Points the link to the pty, replacing an older link but never any other file
+bool createLink(const char * name, const std::string & link)
+{
+  struct stat status;
+  if (lstat(link.c_str(), &status) == 0) {
+    if (!S_ISLNK(status.st_mode)) {
+      std::fprintf(stderr, "%s exists and is not a symbolic link\n", link.c_str());
+      return false;
+    }
+    if (unlink(link.c_str()) != 0) {
+      std::perror("unlink");
+      return false;
+    }
+  } else if (errno != ENOENT) {
+    std::perror("lstat");
+    return false;
+  }
+
+  if (symlink(name, link.c_str()) != 0) {
+    std::perror("symlink");
+    return false;
+  }
+  return true;
+}
+
+// Removes the link if it still points to the pty
+void removeLink(const char * name, const std::string & link)
+{
+  char target[256];
+  ssize_t length = readlink(link.c_str(), target, sizeof(target) - 1);
+  if (length < 0) {return;}
+  target[length] = '\0';
+  if (std::string(target) == name) {
+    unlink(link.c_str());
+  }
+}
+
+// Writes the bytes at the line rate, dropping the ones that do not fit in the pty
+void send(
+  int device, const unsigned char * data, size_t size, const Settings & settings,
+  Statistics & statistics)
+{
+  Clock::time_point start = Clock::now();
+  // start, 8 data bits and stop
+  double byte_time = settings.baud > 0 ? 10.0 / settings.baud : 0.0;
+
+  for (size_t offset = 0; offset < size && g_running; offset += settings.chunk) {
+    size_t length = size - offset < settings.chunk ? size - offset : settings.chunk;
+    ssize_t written = write(device, data + offset, length);
+    if (written < 0) {
+      // Nobody reads the port, like a scanner that is not listened to
+      written = 0;
+    }
+    statistics.dropped_bytes += length - static_cast<size_t>(written);
+
+    if (byte_time > 0.0) {
+      std::this_thread::sleep_until(
+        start + std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>((offset + length) * byte_time)));
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  Settings settings;
+  if (!parseArguments(argc, argv, settings)) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  int master, slave;
+  char name[256];
+  if (openpty(&master, &slave, name, nullptr, nullptr) != 0) {
+    std::perror("openpty");
+    return EXIT_FAILURE;
+  }
+
+  // Pass the bytes untouched until the driver configures the port. The slave is kept
+  // open, so the pty survives the driver closing it.
+  termios tio;
+  tcgetattr(slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave, TCSANOW, &tio);
+  fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+  if (!settings.link.empty() && !createLink(name, settings.link)) {
+    return EXIT_FAILURE;
+  }
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+
+  // One generator per field, all of them with the same scan numbers
+  std::vector<TelegramGenerator> generators;
+  for (int field : settings.fields) {
+    TelegramGenerator::Options options = settings.telegram;
+    options.field = field;
+    generators.emplace_back(options);
+  }
+  TelegramGenerator & generator = generators.front();
+  std::printf(
+    "Emulating an S300 on %s: %zu bytes per telegram, %zu fields, %.1f scans/s\n",
+    settings.link.empty() ? name : settings.link.c_str(), generator.getTelegramSize(),
+    generators.size(), settings.rate);
+  std::fflush(stdout);
+
+  std::mt19937 rng(settings.seed);
+  std::uniform_real_distribution<double> probability(0.0, 1.0);
+  std::vector<unsigned char> telegram;
+  Statistics statistics;
+  unsigned long scans = 0;
+
+  Clock::time_point next_time = Clock::now();
+  while (g_running && (settings.count == 0 || scans < settings.count)) {
+    bool standby = settings.standby_period > 0 &&
+      scans % settings.standby_period >= settings.standby_period - settings.standby_length;
+    for (TelegramGenerator & field : generators) {
+      field.setStandby(standby);
+      const std::vector<unsigned char> & next = field.next();
+      telegram.assign(next.begin(), next.end());
+      size_t size = telegram.size();
+
+      if (settings.bit_errors > 0.0 && probability(rng) < settings.bit_errors) {
+        size_t bit = std::uniform_int_distribution<size_t>(0, 8 * size - 1)(rng);
+        telegram[bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+        statistics.bit_errors++;
+      }
+      if (settings.truncations > 0.0 && probability(rng) < settings.truncations) {
+        size = std::uniform_int_distribution<size_t>(1, size - 1)(rng);
+        statistics.truncations++;
+      }
+
+      send(master, telegram.data(), size, settings, statistics);
+      statistics.telegrams++;
+      statistics.standby += standby;
+    }
+    scans++;
+
+    // The other outputs of the scan follow its measurements, without errors
+    if (settings.reflectors) {
+      const std::vector<unsigned char> & reflectors = generator.nextReflectors();
+      send(master, reflectors.data(), reflectors.size(), settings, statistics);
+    }
+    if (settings.io) {
+      // Synthetic state: the first word is set while the scanner is not in standby
+      const std::vector<unsigned char> & io =
+        generator.nextIo({static_cast<uint16_t>(standby ? 0 : 1), 0});
+      send(master, io.data(), io.size(), settings, statistics);
+    }
+
+    if (settings.rate > 0.0) {
+      next_time += std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / settings.rate));
+      std::this_thread::sleep_until(next_time);
+    }
+  }
+
+  std::printf(
+    "%lu telegrams sent (%lu in standby, %lu with a bit error, %lu truncated), "
+    "%lu bytes dropped\n", statistics.telegrams, statistics.standby, statistics.bit_errors,
+    statistics.truncations, statistics.dropped_bytes);
+
+  if (!settings.link.empty()) {
+    removeLink(name, settings.link);
+  }
+  close(slave);
+  close(master);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,277 @@
+// Copyright (c) 2026 Alberto J. Tudela Roldán
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replays a capture recorded with the capture_file parameter of the driver.
+//
+// By default the bytes are fed to the framer and decoded in this process, as fast as
+// possible unless --speed is given, and the decoding statistics are printed. With --pty
+// they are written to a pseudo-terminal instead, so the driver itself can read them.
+//
+// Usage: s300_replay [options] CAPTURE, see usage() below.
+
+// C
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <pty.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+// C++
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "sicks300_ros2/common/ScannerSickS300.hpp"
+#include "sicks300_ros2/common/SerialCapture.hpp"
+
+namespace
+{
+
+volatile sig_atomic_t g_running = 1;
+
+void stop(int)
+{
+  g_running = 0;
+}
+
+struct Settings
+{
+  double speed = -1.0;           // 1 for real time, 0 as fast as possible
+  bool pty = false;
+  std::string link;
+  size_t first_telegram = 0;
+  bool inverted = false;
+  std::string path;
+};
+
+void usage(const char * name)
+{
+  std::printf(
+    "Usage: %s [options] CAPTURE\n"
+    "  -s, --speed X           replay X times faster than recorded, 0 as fast as possible\n"
+    "                          (default 0, or 1 with --pty)\n"
+    "  -p, --pty               write the bytes to a pseudo-terminal instead of decoding them\n"
+    "  -L, --link PATH         symbolic link to the pseudo-terminal, replaces only a link\n"
+    "  -t, --telegram N        start at the telegram N of the index\n"
+    "  -i, --inverted          decode the measurements in reverse order\n",
+    name);
+}
+
+bool parseArguments(int argc, char ** argv, Settings & settings)
+{
+  const option options[] = {
+    {"speed", required_argument, nullptr, 's'},
+    {"pty", no_argument, nullptr, 'p'},
+    {"link", required_argument, nullptr, 'L'},
+    {"telegram", required_argument, nullptr, 't'},
+    {"inverted", no_argument, nullptr, 'i'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int c;
+  while ((c = getopt_long(argc, argv, "s:pL:t:ih", options, nullptr)) != -1) {
+    switch (c) {
+      case 's': settings.speed = std::atof(optarg); break;
+      case 'p': settings.pty = true; break;
+      case 'L': settings.link = optarg; break;
+      case 't': settings.first_telegram = std::strtoul(optarg, nullptr, 10); break;
+      case 'i': settings.inverted = true; break;
+      default:
+        return false;
+    }
+  }
+  if (optind != argc - 1) {return false;}
+
+  settings.path = argv[optind];
+  if (settings.speed < 0.0) {
+    settings.speed = settings.pty ? 1.0 : 0.0;
+  }
+  return true;
+}
+
+// Points the link to the pty, replacing an older link but never any other file
+bool createLink(const char * name, const std::string & link)
+{
+  struct stat status;
+  if (lstat(link.c_str(), &status) == 0) {
+    if (!S_ISLNK(status.st_mode)) {
+      std::fprintf(stderr, "%s exists and is not a symbolic link\n", link.c_str());
+      return false;
+    }
+    if (unlink(link.c_str()) != 0) {
+      std::perror("unlink");
+      return false;
+    }
+  } else if (errno != ENOENT) {
+    std::perror("lstat");
+    return false;
+  }
+
+  if (symlink(name, link.c_str()) != 0) {
+    std::perror("symlink");
+    return false;
+  }
+  return true;
+}
+
+// Removes the link if it still points to the pty
+void removeLink(const char * name, const std::string & link)
+{
+  char target[256];
+  ssize_t length = readlink(link.c_str(), target, sizeof(target) - 1);
+  if (length < 0) {return;}
+  target[length] = '\0';
+  if (std::string(target) == name) {
+    unlink(link.c_str());
+  }
+}
+
+int replayToPty(const CaptureReader & capture, const Settings & settings, size_t first_chunk)
+{
+  int master, slave;
+  char name[256];
+  if (openpty(&master, &slave, name, nullptr, nullptr) != 0) {
+    std::perror("openpty");
+    return EXIT_FAILURE;
+  }
+  termios tio;
+  tcgetattr(slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave, TCSANOW, &tio);
+  fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+  if (!settings.link.empty() && !createLink(name, settings.link)) {
+    close(slave);
+    close(master);
+    return EXIT_FAILURE;
+  }
+  std::printf(
+    "Replaying on %s at %.1fx\n", settings.link.empty() ? name : settings.link.c_str(),
+    settings.speed);
+  std::fflush(stdout);
+
+  size_t dropped = 0;
+  size_t chunks = capture.replay(
+    settings.speed, [&](const CaptureReader::Chunk & chunk) {
+      ssize_t written = write(master, chunk.data, chunk.size);
+      dropped += chunk.size - (written > 0 ? static_cast<size_t>(written) : 0);
+      return g_running != 0;
+    }, first_chunk);
+  std::printf("%zu chunks replayed, %zu bytes dropped\n", chunks, dropped);
+
+  if (!settings.link.empty()) {
+    removeLink(name, settings.link);
+  }
+  close(slave);
+  close(master);
+  return EXIT_SUCCESS;
+}
+
+int replayToParser(const CaptureReader & capture, const Settings & settings, size_t first_chunk)
+{
+  // Every field is decoded with the default configuration of the driver
+  ScannerSickS300 scanner;
+  ScannerSickS300::ParamType param;
+  param.dScale = 0.01;
+  param.dStartAngle = -2.36;
+  param.dStopAngle = 2.36;
+  for (int field = 1; field <= 5; field++) {
+    param.range_field = field;
+    scanner.setRangeField(field, param);
+  }
+
+  std::vector<float> ranges, intensities;
+  const ScannerSickS300::ScanGeometry * geometry;
+  unsigned int scan_number;
+  size_t scans = 0, standby = 0, bytes = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  size_t chunks = capture.replay(
+    settings.speed, [&](const CaptureReader::Chunk & chunk) {
+      scanner.feed(chunk.data, chunk.size);
+      bytes += chunk.size;
+      while (scanner.nextScan(
+        ranges, intensities, geometry, scan_number, settings.inverted, false))
+      {
+        scans++;
+        standby += scanner.isInStandby();
+      }
+      return g_running != 0;
+    }, first_chunk);
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const std::vector<CaptureReader::Chunk> & all = capture.getChunks();
+  double recorded = chunks > 0 ?
+    (all[first_chunk + chunks - 1].receive_ns - all[first_chunk].receive_ns) * 1e-9 : 0.0;
+
+  std::printf(
+    "%zu chunks, %zu bytes, %.1f s recorded, replayed in %.3f s (%.0fx)\n",
+    chunks, bytes, recorded, elapsed, elapsed > 0.0 ? recorded / elapsed : 0.0);
+  std::printf(
+    "%zu scans decoded (%zu in standby), %u telegrams framed, %u skipped scans, "
+    "%u dropped telegrams\n", scans, standby, scanner.getReceivedTelegrams(),
+    scanner.getSkippedScans(), scanner.getDroppedTelegrams());
+  if (scans > 0) {
+    std::printf("%.0f ns/scan\n", elapsed * 1e9 / scans);
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  Settings settings;
+  if (!parseArguments(argc, argv, settings)) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  CaptureReader capture;
+  if (!capture.open(settings.path.c_str())) {
+    std::fprintf(stderr, "%s is not a capture\n", settings.path.c_str());
+    return EXIT_FAILURE;
+  }
+  std::printf(
+    "%s: %d baud, %zu chunks, %s\n", settings.path.c_str(), capture.getBaudRate(),
+    capture.getChunks().size(),
+    capture.hasIndex() ?
+    (std::to_string(capture.getNumTelegrams()) + " telegrams indexed").c_str() :
+    "no index (the capture was not closed)");
+
+  size_t first_chunk = 0;
+  if (settings.first_telegram > 0) {
+    if (settings.first_telegram >= capture.getNumTelegrams()) {
+      std::fprintf(stderr, "The capture has no telegram %zu\n", settings.first_telegram);
+      return EXIT_FAILURE;
+    }
+    first_chunk = capture.findChunk(
+      capture.getTelegrams()[settings.first_telegram].stream_offset);
+  }
+  if (capture.getChunks().empty()) {return EXIT_SUCCESS;}
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+
+  if (settings.pty) {
+    return replayToPty(capture, settings, first_chunk);
+  }
+  return replayToParser(capture, settings, first_chunk);
+}